@@ -272,6 +272,10 @@ ifeq ($(shell yq r ../targets/$(TARGETNAME).yml analog.extReference), true)
     DEFINES += ADC_EXT_REF
 endif
 
+ifeq ($(shell yq r ../targets/$(TARGETNAME).yml analog.filter), adaptive)
+    DEFINES += ANALOG_FILTER_ADAPTIVE
+endif
+
 ifneq ($(shell yq r ../targets/$(TARGETNAME).yml leds.external),)
     ifeq (,$(findstring LEDS_SUPPORTED,$(DEFINES)))
         DEFINES += LEDS_SUPPORTED
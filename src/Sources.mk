@@ -132,6 +132,10 @@ ifeq (,$(findstring flashgen,$(MAKECMDGOALS)))
             board/$(ARCH)/uart/UART.cpp \
             board/common/uart/UART.cpp
         endif
+
+        ifneq (,$(findstring DIN_MIDI_SUPPORTED,$(DEFINES)))
+            SOURCES += $(shell $(FIND) ./common/DINMIDIencoder -type f -name "*.cpp")
+        endif
     
         ifneq ($(filter %16u2 %8u2, $(TARGETNAME)), )
             #fw for xu2 uses different set of sources than other targets
@@ -1,4 +1,5 @@
 #include "database/Database.h"
+#include "io/buttons/Buttons.h"
 
 void Database::customInitButtons()
 {
@@ -11,6 +12,10 @@ void Database::customInitButtons()
 
     for (int i = 0; i < MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
         update(Database::Section::button_t::midiID, i + MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG, i);
+
+    update(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::longPressTime), BUTTONS_DEFAULT_LONG_PRESS_TIME);
+    update(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::doubleTapTime), BUTTONS_DEFAULT_DOUBLE_TAP_TIME);
+    update(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::repeatTime), BUTTONS_DEFAULT_REPEAT_TIME);
 }
 
 void Database::customInitLEDs()
@@ -75,6 +75,14 @@ class Database : public LESSDB
             midiID,
             velocity,
             midiChannel,
+            debounceTime,
+            debounceMode,
+            longPress,
+            longPressMIDIid,
+            doubleTap,
+            doubleTapMIDIid,
+            repeat,
+            global,
             AMOUNT
         };
 
@@ -100,6 +108,11 @@ class Database : public LESSDB
             lowerLimit,
             upperLimit,
             midiChannel,
+            noiseThreshold,
+            aftertouchType,
+            aftertouchThreshold,
+            global,
+            curve,
             AMOUNT
         };
 
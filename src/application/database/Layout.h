@@ -19,6 +19,9 @@ limitations under the License.
 #pragma once
 
 #include "Database.h"
+#include "io/buttons/Buttons.h"
+#include "io/analog/Analog.h"
+#include "io/analog/Curve.h"
 #include "io/leds/LEDs.h"
 #include "io/display/Display.h"
 #include "io/touchscreen/Touchscreen.h"
@@ -133,6 +136,86 @@ namespace
             .defaultValue           = 0,
             .autoIncrement          = false,
             .address                = 0,
+        },
+
+        //debounce time section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = BUTTONS_DEFAULT_DEBOUNCE_TIME,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //debounce mode section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //long press section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //long press midi id section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //double tap section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //double tap midi id section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //repeat section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //global parameters section
+        {
+            .numberOfParameters     = static_cast<size_t>(IO::Buttons::setting_t::AMOUNT),
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
         }
     };
 
@@ -287,6 +370,56 @@ namespace
             .defaultValue           = 0,
             .autoIncrement          = false,
             .address                = 0,
+        },
+
+        //noise threshold section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ANALOG,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //aftertouch type section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ANALOG,
+            .parameterType          = LESSDB::sectionParameterType_t::halfByte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = static_cast<uint8_t>(IO::Analog::aftertouchType_t::none),
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //aftertouch threshold section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ANALOG,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 2,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //global parameters section
+        {
+            .numberOfParameters     = static_cast<size_t>(IO::Analog::setting_t::AMOUNT),
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 20,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //response curve section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ANALOG,
+            .parameterType          = LESSDB::sectionParameterType_t::halfByte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = static_cast<uint8_t>(IO::AnalogCurve::curve_t::linear),
+            .autoIncrement          = false,
+            .address                = 0,
         }
     };
 
@@ -18,27 +18,57 @@ limitations under the License.
 
 #include "Analog.h"
 #include "core/src/general/Helpers.h"
+#include "core/src/general/Timing.h"
 
 using namespace IO;
 
-void Analog::update()
+///
+/// \brief Pushes enable state of all analog components to hardware so that only enabled ones are read,
+/// precomputes potentiometer scaling and applies stored noise thresholds to filter and aftertouch rate.
+/// Should be called once database is initialized and on preset change.
+///
+void Analog::init()
 {
-    //check values
     for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
     {
-        //don't process component if it's not enabled
-        if (!database.read(Database::Section::analog_t::enable, i))
-            continue;
+        updateScanState(i);
+        updateScaling(i);
+        updateNoiseThreshold(i);
+    }
 
-        uint16_t analogData;
+    updateAftertouchRate();
+}
 
-        if (!hwa.value(i, analogData))
-            continue;
+void Analog::update()
+{
+    uint8_t          indexes[MAX_NUMBER_OF_ANALOG];
+    uint16_t         values[MAX_NUMBER_OF_ANALOG];
+    Filter::sample_t samples[MAX_NUMBER_OF_ANALOG];
 
-        auto type = static_cast<type_t>(database.read(Database::Section::analog_t::type, i));
+    //only enabled components with new readings are reported
+    size_t count = hwa.newValues(indexes, values, MAX_NUMBER_OF_ANALOG);
 
-        if (!filter.isFiltered(i, type, analogData, analogData))
-            continue;
+    if (calibrationActive)
+    {
+        //components are at rest during calibration - don't send anything
+        updateCalibration(indexes, values, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i].index = indexes[i];
+        samples[i].type  = static_cast<type_t>(database.read(Database::Section::analog_t::type, indexes[i]));
+        samples[i].value = values[i];
+    }
+
+    count = filter.filterAll(samples, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto type       = samples[i].type;
+        auto index      = samples[i].index;
+        auto analogData = samples[i].value;
 
         if (type != type_t::button)
         {
@@ -50,11 +80,11 @@ void Analog::update()
             case type_t::nrpn14b:
             case type_t::pitchBend:
             case type_t::cc14bit:
-                checkPotentiometerValue(type, i, analogData);
+                checkPotentiometerValue(type, index, analogData);
                 break;
 
             case type_t::fsr:
-                checkFSRvalue(i, analogData);
+                checkFSRvalue(index, analogData);
                 break;
 
             default:
@@ -64,17 +94,113 @@ void Analog::update()
         else
         {
             if (buttonHandler != nullptr)
-                (*buttonHandler)(i, analogData);
+                (*buttonHandler)(index, analogData);
         }
 
-        cInfo.send(Database::block_t::analog, i);
+        cInfo.send(Database::block_t::analog, index);
+    }
+
+    sendAftertouch();
+}
+
+///
+/// \brief Reads enable state and type of specified analog component from database and passes them to hardware.
+/// Components sending 14-bit values are oversampled to increase effective resolution, and
+/// strike peak is detected on FSR components so that velocity doesn't depend on scan timing.
+///
+void Analog::updateScanState(uint16_t index)
+{
+    auto type = static_cast<type_t>(database.read(Database::Section::analog_t::type, index));
+
+    hwa.setScanState(index, database.read(Database::Section::analog_t::enable, index));
+    hwa.setOversamplingState(index, isOversampled(type));
+    hwa.setPeakDetectionState(index, type == type_t::fsr);
+}
+
+///
+/// \brief Checks whether the components of specified type are oversampled.
+/// Readings of oversampled and plain inputs have different range, and so do their noise thresholds.
+///
+bool Analog::isOversampled(type_t type)
+{
+    return (type == type_t::nrpn14b) || (type == type_t::pitchBend) || (type == type_t::cc14bit);
+}
+
+///
+/// \brief Reads noise threshold of specified analog component from database and passes it to filter.
+///
+void Analog::updateNoiseThreshold(uint16_t index)
+{
+    filter.setNoiseThreshold(index, database.read(Database::Section::analog_t::noiseThreshold, index));
+}
+
+///
+/// \brief Starts measuring noise floor of all enabled analog components.
+/// Once ANALOG_CALIBRATION_TIME passes, peak-to-peak noise of each component is used
+/// to calculate its threshold, which is then stored in database and applied to filter.
+/// No MIDI messages are sent while calibration is active.
+///
+void Analog::startCalibration()
+{
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
+        calibrationMin[i] = 0xFFFF;
+        calibrationMax[i] = 0;
+    }
+
+    calibrationStartTime = core::timing::currentRunTimeMs();
+    calibrationActive    = true;
+}
+
+bool Analog::isCalibrating()
+{
+    return calibrationActive;
+}
+
+void Analog::updateCalibration(const uint8_t* indexes, const uint16_t* values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto index = indexes[i];
+
+        if (values[i] < calibrationMin[index])
+            calibrationMin[index] = values[i];
+
+        if (values[i] > calibrationMax[index])
+            calibrationMax[index] = values[i];
+    }
+
+    if ((core::timing::currentRunTimeMs() - calibrationStartTime) >= ANALOG_CALIBRATION_TIME)
+        finishCalibration();
+}
+
+void Analog::finishCalibration()
+{
+    calibrationActive = false;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
+        //no readings - component is disabled
+        if (calibrationMin[i] > calibrationMax[i])
+            continue;
+
+        //threshold must be larger than peak-to-peak noise so that the noise alone can't be registered as movement
+        uint16_t threshold = calibrationMax[i] - calibrationMin[i] + 1;
+
+        if (threshold > ANALOG_NOISE_THRESHOLD_MAX)
+            threshold = ANALOG_NOISE_THRESHOLD_MAX;
+
+        database.update(Database::Section::analog_t::noiseThreshold, i, threshold);
+        updateNoiseThreshold(i);
     }
 }
 
 void Analog::debounceReset(uint16_t index)
 {
-    fsrPressed[index] = false;
-    lastValue[index]  = 0xFFFF;
+    fsrPressed[index]        = false;
+    lastValue[index]         = 0xFFFF;
+    aftertouchLast[index]    = 0;
+    aftertouchPending[index] = 0xFF;
     filter.reset(index);
 }
 
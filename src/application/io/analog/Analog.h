@@ -27,6 +27,8 @@ limitations under the License.
 #include "io/leds/LEDs.h"
 #include "io/display/Display.h"
 #include "io/common/CInfo.h"
+#include "Constants.h"
+#include "Curve.h"
 
 namespace IO
 {
@@ -53,17 +55,37 @@ namespace IO
             AMOUNT
         };
 
-        enum class pressureType_t : uint8_t
+        enum class aftertouchType_t : uint8_t
         {
-            velocity,
-            aftertouch
+            none,
+            channel,
+            poly,
+            AMOUNT
+        };
+
+        enum class setting_t : uint8_t
+        {
+            aftertouchRate,
+            AMOUNT
         };
 
         class HWA
         {
             public:
-            //should return true if the value has been refreshed, false otherwise
-            virtual bool value(size_t index, uint16_t& value) = 0;
+            //should enable or disable reading of specified analog input
+            virtual void setScanState(size_t index, bool state) = 0;
+
+            //should enable or disable oversampling of specified analog input
+            //readings of oversampled inputs should fill 14-bit range
+            virtual void setOversamplingState(size_t index, bool state) = 0;
+
+            //should enable or disable strike peak detection on specified analog input
+            //once enabled, only the peak of each strike, pressure while pressed and 0 on release should be reported
+            virtual void setPeakDetectionState(size_t index, bool state) = 0;
+
+            //should store indexes and values of all enabled analog inputs which have new readings
+            //returns the amount of stored readings
+            virtual size_t newValues(uint8_t* indexes, uint16_t* values, size_t maxValues) = 0;
         };
 
         class Filter
@@ -75,8 +97,49 @@ namespace IO
                 adc12bit
             };
 
+            ///
+            /// \brief Single analog reading passed to filter.
+            ///
+            struct sample_t
+            {
+                uint16_t       index;    ///< Analog component index.
+                Analog::type_t type;     ///< Type of analog component.
+                uint16_t       value;    ///< Raw value on input, filtered value on output.
+            };
+
             virtual bool isFiltered(size_t index, Analog::type_t type, uint16_t value, uint16_t& filteredValue) = 0;
             virtual void reset(size_t index)                                                                    = 0;
+
+            ///
+            /// \brief Sets minimum difference between two raw readings on specified analog input
+            /// needed to consider that the value has been changed.
+            /// @param [in] index       Analog component index.
+            /// @param [in] threshold   Threshold in raw units of the input readings, which are oversampled for 14-bit types.
+            ///                         If set to 0, filter should use its default thresholds.
+            ///
+            virtual void setNoiseThreshold(size_t index, uint16_t threshold) = 0;
+
+            ///
+            /// \brief Filters all specified samples in single pass.
+            /// Samples which have been filtered are moved to the beginning of the array.
+            /// @param [in,out] samples Array of samples to filter.
+            /// @param [in]     count   Amount of samples in array.
+            /// \returns Amount of samples which have been filtered.
+            ///
+            virtual size_t filterAll(sample_t* samples, size_t count)
+            {
+                size_t filtered = 0;
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    sample_t sample = samples[i];
+
+                    if (isFiltered(sample.index, sample.type, sample.value, sample.value))
+                        samples[filtered++] = sample;
+                }
+
+                return filtered;
+            }
         };
 
         Analog(HWA&           hwa,
@@ -96,18 +159,51 @@ namespace IO
         {
             //make sure the first value is sent even if 0
             for (size_t i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
-                lastValue[i] = 0xFFFF;
+            {
+                lastValue[i]         = 0xFFFF;
+                aftertouchPending[i] = 0xFF;
+            }
         }
 
+        void init();
         void update();
+        void updateScanState(uint16_t index);
+        void updateScaling(uint16_t index);
+        void updateNoiseThreshold(uint16_t index);
+        void updateAftertouchRate();
+        void startCalibration();
+        bool isCalibrating();
         void debounceReset(uint16_t index);
         void setButtonHandler(void (*fptr)(uint8_t adcIndex, bool state));
 
+        static bool isOversampled(type_t type);
+
         private:
+        ///
+        /// \brief Parameters used to scale and send value of single analog component.
+        /// Precomputed from database so that no database reads, splitting or division
+        /// are needed for each new value.
+        ///
+        struct scaling_t
+        {
+            uint32_t             factor     = 0;                               ///< Fixed-point (16.16) multiplier mapping input range to the span between limits.
+            uint16_t             offset     = 0;                               ///< Output value for the lowest input value.
+            uint8_t              midiIDhigh = 0;                               ///< Higher 7 bits of MIDI ID, used for NRPN.
+            uint8_t              midiIDlow  = 0;                               ///< Lower 7 bits of MIDI ID.
+            uint8_t              channel    = 0;                               ///< MIDI channel.
+            bool                 decreasing = false;                           ///< Set if output value decreases as input value increases.
+            AnalogCurve::curve_t curve      = AnalogCurve::curve_t::linear;    ///< Response curve applied before scaling.
+        };
+
         void checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32_t value);
         void checkFSRvalue(uint8_t analogID, uint32_t value);
         bool getFsrPressed(uint8_t fsrID);
         void setFsrPressed(uint8_t fsrID, bool state);
+        void checkAftertouch(uint8_t analogID, uint8_t pressure);
+        void releaseAftertouch(uint8_t analogID);
+        void sendAftertouch();
+        void updateCalibration(const uint8_t* indexes, const uint16_t* values, size_t count);
+        void finishCalibration();
 
         HWA&           hwa;
         Filter&        filter;
@@ -118,8 +214,57 @@ namespace IO
         ComponentInfo& cInfo;
 
         void (*buttonHandler)(uint8_t adcIndex, bool state) = nullptr;
-        uint8_t  fsrPressed[MAX_NUMBER_OF_ANALOG]           = {};
-        uint16_t lastValue[MAX_NUMBER_OF_ANALOG]            = {};
+        uint8_t   fsrPressed[MAX_NUMBER_OF_ANALOG]          = {};
+        uint16_t  lastValue[MAX_NUMBER_OF_ANALOG]           = {};
+        scaling_t scaling[MAX_NUMBER_OF_ANALOG]             = {};
+
+        ///
+        /// \brief Last aftertouch pressure sent for each FSR component.
+        ///
+        uint8_t aftertouchLast[MAX_NUMBER_OF_ANALOG] = {};
+
+        ///
+        /// \brief Aftertouch pressure waiting to be sent for each FSR component.
+        /// 0xFF is used as an indicator that there is nothing to send.
+        ///
+        uint8_t aftertouchPending[MAX_NUMBER_OF_ANALOG] = {};
+
+        ///
+        /// \brief Index of FSR component from which the search for pending aftertouch is started.
+        /// Rotated so that all pads get equal share of available bandwidth.
+        ///
+        uint8_t aftertouchNextIndex = 0;
+
+        ///
+        /// \brief Maximum amount of aftertouch messages per second shared by all FSR components.
+        ///
+        uint16_t aftertouchRate = 0;
+
+        ///
+        /// \brief Available aftertouch bandwidth in thousandths of a message.
+        ///
+        uint32_t aftertouchBudget = 0;
+
+        ///
+        /// \brief Time in milliseconds at which aftertouch bandwidth has been last replenished.
+        ///
+        uint32_t aftertouchRefillTime = 0;
+
+        ///
+        /// \brief Holds true while noise floor of analog inputs is being measured.
+        ///
+        bool calibrationActive = false;
+
+        ///
+        /// \brief Time in milliseconds at which calibration has been started.
+        ///
+        uint32_t calibrationStartTime = 0;
+
+        ///
+        /// \brief Lowest and highest raw readings of each analog input registered during calibration.
+        ///
+        uint16_t calibrationMin[MAX_NUMBER_OF_ANALOG] = {};
+        uint16_t calibrationMax[MAX_NUMBER_OF_ANALOG] = {};
     };
 
     /// @}
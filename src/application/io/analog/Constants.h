@@ -0,0 +1,53 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+///
+/// \brief Time in milliseconds during which noise floor of analog inputs is measured in calibration mode.
+/// All analog components should be left at rest during this time.
+///
+#define ANALOG_CALIBRATION_TIME 2000
+
+///
+/// \brief Maximum noise threshold in raw ADC units which can be stored for single analog input.
+/// Value of 0 is used to indicate that the channel isn't calibrated and that default thresholds should be used.
+///
+#define ANALOG_NOISE_THRESHOLD_MAX 127
+
+///
+/// \brief Bit set in filtered value of FSR component when the value is pressure of already pressed sensor.
+/// Used to distinguish aftertouch pressure, which can be 0, from strike velocity and release.
+///
+#define ANALOG_FSR_PRESSURE_FLAG 0x8000
+
+///
+/// \brief Amount of aftertouch messages per second represented by single unit of aftertouch rate setting.
+///
+#define ANALOG_AFTERTOUCH_RATE_UNIT 10
+
+///
+/// \brief Maximum value of aftertouch rate setting.
+///
+#define ANALOG_AFTERTOUCH_RATE_MAX 100
+
+///
+/// \brief Time in milliseconds for which unused aftertouch bandwidth is saved up.
+/// Allows short bursts (eg. several pads pressed at once) while keeping the average rate.
+///
+#define ANALOG_AFTERTOUCH_BURST_TIME 100
@@ -0,0 +1,123 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <stddef.h>
+#include "Curve.h"
+
+using namespace IO;
+
+namespace
+{
+    //steepness of logarithmic and exponential curves
+    //larger value results in steeper curve
+    constexpr double CURVE_STEEPNESS = 4.0;
+
+    ///
+    /// \brief Compile-time e^x calculated from Taylor series.
+    /// Sufficiently accurate for the range of curve arguments.
+    ///
+    constexpr double expSeries(double x, uint8_t n, double term)
+    {
+        return n > 30 ? 0 : term + expSeries(x, n + 1, term * x / (n + 1));
+    }
+
+    constexpr double exponential(double x)
+    {
+        return (expSeries(CURVE_STEEPNESS * x, 0, 1) - 1) / (expSeries(CURVE_STEEPNESS, 0, 1) - 1);
+    }
+
+    constexpr double logarithmic(double x)
+    {
+        //mirrored exponential curve
+        return 1 - exponential(1 - x);
+    }
+
+    constexpr double sCurve(double x)
+    {
+        //smoothstep
+        return x * x * (3 - 2 * x);
+    }
+
+    constexpr uint16_t point(double y)
+    {
+        return static_cast<uint16_t>(y * AnalogCurve::RANGE + 0.5);
+    }
+
+    template<size_t... I>
+    struct indexList
+    {};
+
+    template<size_t N, size_t... I>
+    struct makeIndexList : makeIndexList<N - 1, N - 1, I...>
+    {};
+
+    template<size_t... I>
+    struct makeIndexList<0, I...>
+    {
+        using type = indexList<I...>;
+    };
+
+    template<size_t... I>
+    constexpr AnalogCurve::table_t makeTable(double (*curve)(double), indexList<I...>)
+    {
+        return { { point(curve(static_cast<double>(I) / AnalogCurve::SEGMENTS))... } };
+    }
+}    // namespace
+
+constexpr AnalogCurve::table_t AnalogCurve::tables[static_cast<uint8_t>(curve_t::AMOUNT) - 1] = {
+    makeTable(logarithmic, makeIndexList<AnalogCurve::SEGMENTS + 1>::type()),
+    makeTable(exponential, makeIndexList<AnalogCurve::SEGMENTS + 1>::type()),
+    makeTable(sCurve, makeIndexList<AnalogCurve::SEGMENTS + 1>::type()),
+};
+
+///
+/// \brief Applies response curve to 7-bit or 14-bit value.
+/// Both endpoints are preserved, so 0 results in 0 and maximum value in maximum value.
+/// @param [in] curve       Curve to apply.
+/// @param [in] value       Value to transform.
+/// @param [in] use14bit    Set to true if the value is in 14-bit range, false for 7-bit range.
+/// \returns Transformed value in the same range as input value.
+///
+uint16_t AnalogCurve::apply(curve_t curve, uint16_t value, bool use14bit)
+{
+    if ((curve == curve_t::linear) || (curve >= curve_t::AMOUNT))
+        return value;
+
+    uint32_t maxValue = use14bit ? 16383 : 127;
+
+    if (value > maxValue)
+        value = maxValue;
+
+    uint32_t position = (value * (use14bit ? NORMALIZE_14BIT : NORMALIZE_7BIT)) >> 16;
+    uint32_t segment  = position >> SEGMENT_SHIFT;
+    auto&    table    = tables[static_cast<uint8_t>(curve) - 1];
+    uint32_t output;
+
+    if (segment >= SEGMENTS)
+    {
+        output = table.point[SEGMENTS];
+    }
+    else
+    {
+        uint32_t fraction = position & ((1 << SEGMENT_SHIFT) - 1);
+        output            = table.point[segment] + (((table.point[segment + 1] - table.point[segment]) * fraction) >> SEGMENT_SHIFT);
+    }
+
+    //back to input range, rounded
+    return ((output * maxValue) + (RANGE >> 1)) >> RANGE_SHIFT;
+}
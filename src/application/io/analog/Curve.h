@@ -0,0 +1,80 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+
+namespace IO
+{
+    ///
+    /// \brief Non-linear response curves for analog components.
+    /// Each curve is stored as a small table of points generated at compile time.
+    /// Values between the points are linearly interpolated so that the cost is
+    /// constant and the output is monotonic.
+    ///
+    class AnalogCurve
+    {
+        public:
+        enum class curve_t : uint8_t
+        {
+            linear,
+            logarithmic,
+            exponential,
+            sCurve,
+            AMOUNT
+        };
+
+        ///
+        /// \brief Amount of segments between table points.
+        ///
+        static constexpr uint16_t SEGMENTS = 16;
+
+        ///
+        /// \brief Full range of curve input and output.
+        /// Power of two so that the scaling needs shifts only.
+        ///
+        static constexpr uint32_t RANGE_SHIFT = 15;
+        static constexpr uint32_t RANGE       = static_cast<uint32_t>(1) << RANGE_SHIFT;
+
+        ///
+        /// \brief Holds points of single curve, including both endpoints.
+        ///
+        struct table_t
+        {
+            uint16_t point[SEGMENTS + 1];
+        };
+
+        static uint16_t apply(curve_t curve, uint16_t value, bool use14bit);
+
+        private:
+        static constexpr uint32_t SEGMENT_SHIFT = 11;
+
+        static_assert((RANGE >> SEGMENT_SHIFT) == SEGMENTS, "Segment shift doesn't match amount of segments.");
+
+        ///
+        /// \brief Factors used to normalize 7-bit and 14-bit values to curve range.
+        /// Rounded up so that the maximum value always results in the end of the range.
+        ///
+        static constexpr uint32_t NORMALIZE_7BIT  = ((RANGE << 16) + 127 - 1) / 127;
+        static constexpr uint32_t NORMALIZE_14BIT = ((RANGE << 16) + 16383 - 1) / 16383;
+
+        //linear curve needs no table
+        static const table_t tables[static_cast<uint8_t>(curve_t::AMOUNT) - 1];
+    };
+}    // namespace IO
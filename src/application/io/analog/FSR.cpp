@@ -16,11 +16,18 @@ limitations under the License.
 
 */
 
+#include <stdlib.h>
 #include "Analog.h"
 #include "core/src/general/Helpers.h"
+#include "core/src/general/Timing.h"
 
 using namespace IO;
 
+//aftertouch bandwidth is kept in thousandths of a message so that it can be
+//replenished every millisecond without rounding errors
+#define AFTERTOUCH_MESSAGE_COST 1000
+#define AFTERTOUCH_NO_PENDING   0xFF
+
 bool Analog::getFsrPressed(uint8_t fsrID)
 {
     return fsrPressed[fsrID];
@@ -33,17 +40,32 @@ void Analog::setFsrPressed(uint8_t fsrID, bool state)
 
 void Analog::checkFSRvalue(uint8_t analogID, uint32_t value)
 {
+    if (value & ANALOG_FSR_PRESSURE_FLAG)
+    {
+        //pressure of already pressed sensor
+        if (getFsrPressed(analogID))
+            checkAftertouch(analogID, AnalogCurve::apply(scaling[analogID].curve, value & ~ANALOG_FSR_PRESSURE_FLAG, false));
+
+        return;
+    }
+
     if (value > 0)
     {
         if (!getFsrPressed(analogID))
         {
             //sensor is really pressed
             setFsrPressed(analogID, true);
-            uint8_t note    = database.read(Database::Section::analog_t::midiID, analogID);
-            uint8_t channel = database.read(Database::Section::analog_t::midiChannel, analogID);
-            midi.sendNoteOn(note, value, channel);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOn, note, value, channel + 1);
-            leds.midiToState(MIDI::messageType_t::noteOn, note, value, channel, true);
+            uint8_t note     = database.read(Database::Section::analog_t::midiID, analogID);
+            uint8_t channel  = database.read(Database::Section::analog_t::midiChannel, analogID);
+            uint8_t velocity = AnalogCurve::apply(scaling[analogID].curve, value, false);
+
+            //pressed sensor must never be sent as note off
+            if (!velocity)
+                velocity = 1;
+
+            midi.sendNoteOn(note, velocity, channel);
+            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOn, note, velocity, channel + 1);
+            leds.midiToState(MIDI::messageType_t::noteOn, note, velocity, channel, true);
         }
     }
     else
@@ -56,8 +78,130 @@ void Analog::checkFSRvalue(uint8_t analogID, uint32_t value)
             midi.sendNoteOff(note, 0, channel);
             display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOff, note, value, channel + 1);
             leds.midiToState(MIDI::messageType_t::noteOff, note, 0, channel, true);
+            releaseAftertouch(analogID);
         }
     }
 
     lastValue[analogID] = value;
-}
\ No newline at end of file
+}
+
+///
+/// \brief Queues new aftertouch pressure of pressed FSR component if it differs enough from the last one sent.
+/// Only the latest pressure is kept so that the stream never lags behind the sensor when bandwidth is limited.
+/// @param [in] analogID    Index of FSR component.
+/// @param [in] pressure    Current pressure in range 0-127.
+///
+void Analog::checkAftertouch(uint8_t analogID, uint8_t pressure)
+{
+    if (static_cast<aftertouchType_t>(database.read(Database::Section::analog_t::aftertouchType, analogID)) == aftertouchType_t::none)
+        return;
+
+    uint8_t diff = abs(pressure - aftertouchLast[analogID]);
+
+    //always allow the limits to be reached even if the change is below the threshold
+    if ((diff >= database.read(Database::Section::analog_t::aftertouchThreshold, analogID)) ||
+        (diff && ((pressure == 0) || (pressure == MIDI_7_BIT_VALUE_MAX))))
+        aftertouchPending[analogID] = pressure;
+    else
+        aftertouchPending[analogID] = AFTERTOUCH_NO_PENDING;
+}
+
+///
+/// \brief Discards pending aftertouch of released FSR component.
+/// Poly aftertouch ends with note off, while channel pressure has to be explicitly reset to 0.
+/// @param [in] analogID    Index of FSR component.
+///
+void Analog::releaseAftertouch(uint8_t analogID)
+{
+    aftertouchPending[analogID] = AFTERTOUCH_NO_PENDING;
+
+    switch (static_cast<aftertouchType_t>(database.read(Database::Section::analog_t::aftertouchType, analogID)))
+    {
+    case aftertouchType_t::channel:
+    {
+        if (aftertouchLast[analogID])
+            aftertouchPending[analogID] = 0;
+    }
+    break;
+
+    default:
+    {
+        aftertouchLast[analogID] = 0;
+    }
+    break;
+    }
+}
+
+///
+/// \brief Reads maximum amount of aftertouch messages per second from database.
+///
+void Analog::updateAftertouchRate()
+{
+    aftertouchRate       = database.read(Database::Section::analog_t::global, static_cast<size_t>(setting_t::aftertouchRate)) * ANALOG_AFTERTOUCH_RATE_UNIT;
+    aftertouchBudget     = 0;
+    aftertouchRefillTime = core::timing::currentRunTimeMs();
+}
+
+///
+/// \brief Sends pending aftertouch messages of all FSR components.
+/// All components share single bandwidth budget which is replenished at configured rate
+/// so that the total amount of aftertouch messages never exceeds it, regardless of
+/// the amount of pressed pads. Unused budget is saved for up to ANALOG_AFTERTOUCH_BURST_TIME.
+///
+void Analog::sendAftertouch()
+{
+    uint32_t currentTime = core::timing::currentRunTimeMs();
+    uint32_t elapsed     = currentTime - aftertouchRefillTime;
+    uint32_t maxBudget   = static_cast<uint32_t>(aftertouchRate) * ANALOG_AFTERTOUCH_BURST_TIME;
+
+    if (maxBudget < AFTERTOUCH_MESSAGE_COST)
+        maxBudget = AFTERTOUCH_MESSAGE_COST;
+
+    //avoid overflow after long inactivity - budget is limited anyways
+    if (elapsed > ANALOG_AFTERTOUCH_BURST_TIME)
+        elapsed = ANALOG_AFTERTOUCH_BURST_TIME;
+
+    aftertouchRefillTime = currentTime;
+    aftertouchBudget += elapsed * aftertouchRate;
+
+    if (aftertouchBudget > maxBudget)
+        aftertouchBudget = maxBudget;
+
+    for (size_t i = 0; (i < MAX_NUMBER_OF_ANALOG) && (aftertouchBudget >= AFTERTOUCH_MESSAGE_COST); i++)
+    {
+        uint8_t index = aftertouchNextIndex;
+
+        if (++aftertouchNextIndex >= MAX_NUMBER_OF_ANALOG)
+            aftertouchNextIndex = 0;
+
+        uint8_t pressure = aftertouchPending[index];
+
+        if (pressure == AFTERTOUCH_NO_PENDING)
+            continue;
+
+        aftertouchPending[index] = AFTERTOUCH_NO_PENDING;
+        aftertouchLast[index]    = pressure;
+
+        uint8_t channel = database.read(Database::Section::analog_t::midiChannel, index);
+
+        switch (static_cast<aftertouchType_t>(database.read(Database::Section::analog_t::aftertouchType, index)))
+        {
+        case aftertouchType_t::channel:
+        {
+            midi.sendAfterTouch(pressure, channel);
+        }
+        break;
+
+        case aftertouchType_t::poly:
+        {
+            midi.sendAfterTouch(pressure, channel, database.read(Database::Section::analog_t::midiID, index));
+        }
+        break;
+
+        default:
+            continue;
+        }
+
+        aftertouchBudget -= AFTERTOUCH_MESSAGE_COST;
+    }
+}
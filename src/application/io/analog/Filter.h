@@ -29,13 +29,27 @@ namespace IO
     class EMA
     {
         //exponential moving average filter
+        //new sample is weighted with weight/8 so that only shifts are needed instead of division
+        //value is kept with two fractional bits for increased precision with small weights and
+        //each step is rounded away from zero so that the output always settles exactly on the input
         public:
         EMA() = default;
 
-        uint16_t value(uint16_t rawData)
+        static constexpr uint32_t WEIGHT_FAST = 5;    ///< ~60% - used for 7-bit values for fast response.
+        static constexpr uint32_t WEIGHT_SLOW = 2;    ///< 25% - used for oversampled 14-bit values to integrate more readings.
+        static constexpr uint32_t WEIGHT_MIN  = 1;    ///< 12.5% - heaviest filtering.
+        static constexpr uint32_t WEIGHT_MAX  = 8;    ///< 100% - no filtering.
+
+        uint16_t value(uint16_t rawData, uint32_t weight)
         {
-            _currentValue = (_percentage * static_cast<uint32_t>(rawData) + (100 - _percentage) * static_cast<uint32_t>(_currentValue)) / 100;
-            return _currentValue;
+            uint32_t target = static_cast<uint32_t>(rawData) << _fractionBits;
+
+            if (target > _currentValue)
+                _currentValue += (weight * (target - _currentValue) + (1 << _weightShift) - 1) >> _weightShift;
+            else
+                _currentValue -= (weight * (_currentValue - target) + (1 << _weightShift) - 1) >> _weightShift;
+
+            return (_currentValue + (1 << (_fractionBits - 1))) >> _fractionBits;
         }
 
         void reset()
@@ -45,30 +59,130 @@ namespace IO
 
         private:
         uint16_t                  _currentValue = 0;
-        static constexpr uint32_t _percentage   = 60;
+        static constexpr uint32_t _weightShift  = 3;
+        static constexpr uint32_t _fractionBits = 2;
     };
 
     class AnalogFilter : public IO::Analog::Filter
     {
         public:
-        AnalogFilter(IO::Analog::Filter::adcType_t adcType, size_t stableValueRepetitions)
+        enum class filterMode_t : uint8_t
+        {
+            timed,       ///< Light filtering for fixed time after the last movement, median of three readings otherwise.
+            adaptive,    ///< Filtering depth follows estimated movement speed of each channel.
+        };
+
+        AnalogFilter(IO::Analog::Filter::adcType_t adcType, size_t stableValueRepetitions, filterMode_t filterMode = filterMode_t::timed)
             : _adcType(adcType)
             , _adcConfig(adcType == IO::Analog::Filter::adcType_t::adc10bit ? adc10bit : adc12bit)
             , _stableValueRepetitions(stableValueRepetitions)
-        {}
+            , _filterMode(filterMode)
+            , _scale7Bit(scaleFactor(_adcConfig.adcMaxValue, MIDI_7_BIT_VALUE_MAX))
+            , _scale14Bit(scaleFactor(_adcConfig.adcMaxValue14Bit, MIDI_14_BIT_VALUE_MAX))
+            , _scaleFSR(scaleFactor(_adcConfig.fsrMaxValue - _adcConfig.fsrMinValue, MIDI_7_BIT_VALUE_MAX))
+            , _scaleAftertouch(scaleFactor(_adcConfig.aftertouchMaxValue - _adcConfig.fsrMinValue, MIDI_7_BIT_VALUE_MAX))
+        {
+            for (size_t i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+                reset(i);
+        }
 
         bool isFiltered(size_t index, Analog::type_t type, uint16_t value, uint16_t& filteredValue) override
         {
-            auto compare = [](const void* a, const void* b) {
-                if (*(uint16_t*)a < *(uint16_t*)b)
-                    return -1;
-                else if (*(uint16_t*)a > *(uint16_t*)b)
-                    return 1;
+            return filter(index, type, value, filteredValue, currentTime());
+        }
+
+        size_t filterAll(sample_t* samples, size_t count) override
+        {
+            uint16_t time     = currentTime();
+            size_t   filtered = 0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                sample_t sample = samples[i];
+
+                if (filter(sample.index, sample.type, sample.value, sample.value, time))
+                    samples[filtered++] = sample;
+            }
 
-                return 0;
+            return filtered;
+        }
+
+        void reset(size_t index) override
+        {
+            _state[index].sampleCounter = 0;
+            _state[index].emaFilter.reset();
+
+            //make sure the filter follows the new value quickly
+            if (_filterMode == filterMode_t::adaptive)
+                _state[index].speed = SPEED_MAX;
+        }
+
+        void setNoiseThreshold(size_t index, uint16_t threshold) override
+        {
+            _noiseThreshold[index] = threshold;
+        }
+
+        private:
+        enum class valDirection_t : uint8_t
+        {
+            initial,
+            decreasing,
+            increasing
+        };
+
+        ///
+        /// \brief Filtering state of single analog channel.
+        /// Fields are sized to the range of values they hold and ordered so that
+        /// there is no padding on either 8-bit or 32-bit MCUs.
+        /// Fields used in single filtering mode only share the storage.
+        ///
+        struct channelState_t
+        {
+            uint16_t sample[3]       = {};    ///< Last three raw samples, used to calculate median.
+            EMA      emaFilter;               ///< Exponential moving average filter state.
+            uint16_t lastStableValue = 0;     ///< Last accepted raw value.
+
+            union
+            {
+                uint16_t lastMovementTime = 0;    ///< Timed mode: lower 16 bits of run time in milliseconds at which the last value has been accepted.
+                uint16_t speed;                   ///< Adaptive mode: estimated movement speed in raw units per reading, with SPEED_FRACTION_BITS fractional bits.
             };
 
-            if (_adcType == Analog::Filter::adcType_t::adc12bit)
+            uint8_t        stableSampleCount = 0;                          ///< Amount of consecutive readings equal to the new value.
+            uint8_t        sampleCounter     = 0;                          ///< Amount of raw samples collected for the median. In adaptive mode, 0 until the first sample.
+            valDirection_t lastDirection     = valDirection_t::initial;    ///< Direction of the last accepted change.
+            bool           fastFilter        = true;                       ///< Set while fast filter is active, that is, shortly after the last movement.
+        };
+
+        ///
+        /// \brief Amount of fractional bits in estimated movement speed.
+        ///
+        static constexpr uint32_t SPEED_FRACTION_BITS = 2;
+
+        ///
+        /// \brief Estimated speed decays by 1/(2^SPEED_DECAY_SHIFT) of the difference on each reading once the movement slows down.
+        ///
+        static constexpr uint32_t SPEED_DECAY_SHIFT = 2;
+
+        static constexpr uint16_t SPEED_MAX = 0xFFFF;    ///< Used after reset so that the filter follows new value quickly.
+
+        ///
+        /// \brief Returns current run time truncated to 16 bits.
+        /// Sufficient since it's only compared with short timeouts.
+        ///
+        static uint16_t currentTime()
+        {
+            return core::timing::currentRunTimeMs();
+        }
+
+        bool filter(size_t index, Analog::type_t type, uint16_t value, uint16_t& filteredValue, uint16_t time)
+        {
+            auto& state = _state[index];
+
+            //14-bit values are read from oversampled inputs and have different range
+            bool use14bit = (type == Analog::type_t::nrpn14b) || (type == Analog::type_t::pitchBend) || (type == Analog::type_t::cc14bit);
+
+            if ((_adcType == Analog::Filter::adcType_t::adc12bit) && !use14bit)
             {
                 //on 12bit ADCs, when the value is above 90%, add small value
                 //to offset the reading error and possible situation that the maximum
@@ -91,126 +205,244 @@ namespace IO
                 return true;
             }
 
-            bool fastFilter = true;
-
-            if ((core::timing::currentRunTimeMs() - _lastMovementTime[index]) > _fastFilterEnableAfter)
+            //fsr readings come from peak detector and need no further filtering:
+            //strike peak, followed by current pressure while pressed, and 0 on release
+            if (type == Analog::type_t::fsr)
             {
-                fastFilter                                    = false;
-                _analogSample[index][_sampleCounter[index]++] = value;
-
-                //take the median value to avoid using outliers
-                if (_sampleCounter[index] == 3)
+                if (!value)
                 {
-                    qsort(_analogSample[index], 3, sizeof(uint16_t), compare);
-                    _sampleCounter[index] = 0;
-                    filteredValue         = _analogSample[index][1];
+                    filteredValue = 0;
+                }
+                else if (!state.lastStableValue)
+                {
+                    filteredValue = scaleValue(CONSTRAIN(value, _adcConfig.fsrMinValue, _adcConfig.fsrMaxValue) - _adcConfig.fsrMinValue, _scaleFSR);
+
+                    //pressed sensor must never be reported as released
+                    if (!filteredValue)
+                        filteredValue = 1;
                 }
                 else
                 {
-                    return false;
+                    //pressure is mapped to aftertouch range and flagged since it can be 0
+                    filteredValue = scaleValue(CONSTRAIN(value, _adcConfig.fsrMinValue, _adcConfig.aftertouchMaxValue) - _adcConfig.fsrMinValue, _scaleAftertouch);
+                    filteredValue |= ANALOG_FSR_PRESSURE_FLAG;
                 }
-            }
-            else
-            {
-                filteredValue = value;
-            }
 
-            //pass the value through exponential moving average filter for increased stability
-            filteredValue = _emaFilter[index].value(filteredValue);
+                state.lastStableValue = value;
+                return true;
+            }
 
-            bool     use14bit = false;
             uint16_t maxLimit;
+            uint16_t adcMaxValue;
             uint16_t stepDiff;
-
-            if ((type == Analog::type_t::nrpn14b) || (type == Analog::type_t::pitchBend) || (type == Analog::type_t::cc14bit))
-                use14bit = true;
+            uint16_t stepDiffDirChange;
+            uint32_t scale;
 
             if (use14bit)
             {
-                maxLimit = MIDI_14_BIT_VALUE_MAX;
-                stepDiff = _adcConfig.stepDiff14Bit;
+                maxLimit          = MIDI_14_BIT_VALUE_MAX;
+                adcMaxValue       = _adcConfig.adcMaxValue14Bit;
+                stepDiff          = _adcConfig.stepDiff14Bit;
+                stepDiffDirChange = _adcConfig.stepDiffDirChange14Bit;
+                scale             = _scale14Bit;
             }
             else
             {
-                maxLimit = MIDI_7_BIT_VALUE_MAX;
-                stepDiff = _adcConfig.stepDiff7Bit;
+                maxLimit          = MIDI_7_BIT_VALUE_MAX;
+                adcMaxValue       = _adcConfig.adcMaxValue;
+                stepDiff          = _adcConfig.stepDiff7Bit;
+                stepDiffDirChange = _adcConfig.stepDiffDirChange;
+                scale             = _scale7Bit;
+            }
+
+            //calibrated channels use measured noise floor instead of default thresholds
+            if (_noiseThreshold[index])
+            {
+                stepDiff          = _noiseThreshold[index];
+                stepDiffDirChange = _noiseThreshold[index];
+            }
+
+            if (_filterMode == filterMode_t::adaptive)
+            {
+                filteredValue = adaptiveFilter(state, value, stepDiff);
+            }
+            else
+            {
+                if (state.fastFilter && (static_cast<uint16_t>(time - state.lastMovementTime) > _fastFilterEnableAfter))
+                    state.fastFilter = false;
+
+                if (!state.fastFilter)
+                {
+                    state.sample[state.sampleCounter++] = value;
+
+                    //take the median value to avoid using outliers
+                    if (state.sampleCounter == 3)
+                    {
+                        state.sampleCounter = 0;
+                        filteredValue       = median(state.sample[0], state.sample[1], state.sample[2]);
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    filteredValue = value;
+                }
+
+                //pass the value through exponential moving average filter for increased stability
+                //14-bit values are integrated over longer period to average out the noise
+                filteredValue = state.emaFilter.value(filteredValue, use14bit ? EMA::WEIGHT_SLOW : EMA::WEIGHT_FAST);
             }
 
             //if the first read value is 0, mark it as increasing
-            valDirection_t direction = filteredValue >= _lastStableValue[index] ? valDirection_t::increasing : valDirection_t::decreasing;
+            auto direction    = filteredValue >= state.lastStableValue ? valDirection_t::increasing : valDirection_t::decreasing;
+            bool initialValue = state.lastDirection == valDirection_t::initial;
 
             //don't perform these checks on initial value readout
-            if (_lastDirection[index] != valDirection_t::initial)
+            if (!initialValue)
             {
-                if (direction != _lastDirection[index])
-                    stepDiff = _adcConfig.stepDiffDirChange;
+                if (direction != state.lastDirection)
+                    stepDiff = stepDiffDirChange;
+
+                //edges of the range are always accepted so that they can be reached regardless of the threshold
+                bool edgeValue = (filteredValue == 0) || (filteredValue >= adcMaxValue);
 
-                if (abs(filteredValue - _lastStableValue[index]) < stepDiff)
+                if ((abs(filteredValue - state.lastStableValue) < stepDiff) && !edgeValue)
                 {
-                    _stableSampleCount[index] = 0;
+                    state.stableSampleCount = 0;
                     return false;
                 }
             }
 
-            auto midiValue    = core::misc::mapRange(static_cast<uint32_t>(filteredValue), static_cast<uint32_t>(0), static_cast<uint32_t>(_adcConfig.adcMaxValue), static_cast<uint32_t>(0), static_cast<uint32_t>(maxLimit));
-            auto oldMIDIvalue = core::misc::mapRange(static_cast<uint32_t>(_lastStableValue[index]), static_cast<uint32_t>(0), static_cast<uint32_t>(_adcConfig.adcMaxValue), static_cast<uint32_t>(0), static_cast<uint32_t>(maxLimit));
+            auto midiValue    = scaleValue(filteredValue, scale);
+            auto oldMIDIvalue = scaleValue(state.lastStableValue, scale);
 
             //this will allow value 0 as the first sent value
-            if ((midiValue == oldMIDIvalue) && (_lastDirection[index] != valDirection_t::initial))
+            if ((midiValue == oldMIDIvalue) && !initialValue)
             {
-                _stableSampleCount[index] = 0;
+                state.stableSampleCount = 0;
                 return false;
             }
 
-            auto acceptNewValue = [&]() {
-                _stableSampleCount[index] = 0;
-                _lastDirection[index]     = direction;
-                _lastStableValue[index]   = filteredValue;
-                _sampleCounter[index]     = 0;
-                _lastMovementTime[index]  = core::timing::currentRunTimeMs();
-            };
-
-            if (fastFilter)
+            if (!state.fastFilter)
             {
-                acceptNewValue();
+                if (++state.stableSampleCount < _stableValueRepetitions)
+                    return false;
             }
-            else
+
+            state.stableSampleCount = 0;
+            state.lastDirection     = direction;
+            state.lastStableValue   = filteredValue;
+
+            if (_filterMode == filterMode_t::timed)
             {
-                if (++_stableSampleCount[index] >= _stableValueRepetitions)
-                    acceptNewValue();
-                else
-                    return false;
+                state.sampleCounter    = 0;
+                state.lastMovementTime = time;
+                state.fastFilter       = true;
             }
 
-            if (type == Analog::type_t::fsr)
+            filteredValue = midiValue;
+
+            //when edge values are reached, disable fast filter
+            if ((midiValue == 0) || (midiValue == maxLimit))
+                state.fastFilter = false;
+
+            return true;
+        }
+
+        ///
+        /// \brief Filters single reading with filtering depth chosen from estimated movement speed.
+        /// Speed is estimated from the median of the last three readings so that single outliers
+        /// can't be mistaken for movement. It follows any increase immediately and decays gradually,
+        /// so that the filter is light during the entire movement and gets heavier only once
+        /// the movement stops. At rest, the heaviest filtering is used to suppress the jitter.
+        /// @param [in,out] state       Filtering state of the channel.
+        /// @param [in]     value       Raw reading.
+        /// @param [in]     noise       Noise threshold of the channel in raw units.
+        /// \returns Filtered value.
+        ///
+        uint16_t adaptiveFilter(channelState_t& state, uint16_t value, uint16_t noise)
+        {
+            if (!state.sampleCounter)
             {
-                filteredValue = core::misc::mapRange(CONSTRAIN(filteredValue, static_cast<uint32_t>(_adcConfig.fsrMinValue), static_cast<uint32_t>(_adcConfig.fsrMaxValue)), static_cast<uint32_t>(_adcConfig.fsrMinValue), static_cast<uint32_t>(_adcConfig.fsrMaxValue), static_cast<uint32_t>(0), static_cast<uint32_t>(MIDI_7_BIT_VALUE_MAX));
+                //start from the first reading so that the median doesn't include empty samples
+                state.sample[0]     = value;
+                state.sample[1]     = value;
+                state.sample[2]     = value;
+                state.sampleCounter = 1;
             }
+
+            uint16_t lastMedian = median(state.sample[0], state.sample[1], state.sample[2]);
+
+            //sliding median delays the movement by single reading only
+            state.sample[0] = state.sample[1];
+            state.sample[1] = state.sample[2];
+            state.sample[2] = value;
+
+            uint16_t medianValue = median(state.sample[0], state.sample[1], state.sample[2]);
+            uint32_t speed       = static_cast<uint32_t>(abs(medianValue - lastMedian)) << SPEED_FRACTION_BITS;
+
+            if (speed >= state.speed)
+                state.speed = speed > SPEED_MAX ? SPEED_MAX : speed;
             else
+                state.speed -= (state.speed - speed + (1 << SPEED_DECAY_SHIFT) - 1) >> SPEED_DECAY_SHIFT;
+
+            //each noise threshold of speed makes the filter lighter by one step
+            //thresholds are added up instead of dividing since there are only few steps
+            uint32_t weight    = EMA::WEIGHT_MIN;
+            uint32_t step      = static_cast<uint32_t>(noise) << SPEED_FRACTION_BITS;
+            uint32_t threshold = step;
+
+            while ((weight < EMA::WEIGHT_MAX) && (state.speed >= threshold))
             {
-                filteredValue = midiValue;
+                weight++;
+                threshold += step;
             }
 
-            //when edge values are reached, disable fast filter by resetting last movement time
-            if ((midiValue == 0) || (midiValue == maxLimit))
-                _lastMovementTime[index] = 0;
+            //stable value repetitions are required only at rest
+            state.fastFilter = weight > EMA::WEIGHT_MIN;
 
-            return true;
+            return state.emaFilter.value(medianValue, weight);
         }
 
-        void reset(size_t index) override
+        ///
+        /// \brief Returns median of three values using min/max network only.
+        /// Compiles to conditional moves/selects instead of branches on most targets.
+        ///
+        static uint16_t median(uint16_t a, uint16_t b, uint16_t c)
+        {
+            uint16_t low  = a < b ? a : b;
+            uint16_t high = a < b ? b : a;
+
+            high = high < c ? high : c;
+
+            return low > high ? low : high;
+        }
+
+        ///
+        /// \brief Returns 16.16 fixed-point factor used to scale values from range 0-inMax to range 0-outMax.
+        /// Factor is rounded up so that inMax is always scaled to outMax.
+        ///
+        static constexpr uint32_t scaleFactor(uint32_t inMax, uint32_t outMax)
         {
-            _sampleCounter[index] = 0;
-            _emaFilter[index].reset();
+            return ((outMax << 16) + inMax - 1) / inMax;
+        }
+
+        static uint16_t scaleValue(uint32_t value, uint32_t factor)
+        {
+            return (value * factor) >> 16;
         }
 
-        private:
         using adcConfig_t = struct
         {
             const uint16_t adcMaxValue;                 ///< Maxmimum raw ADC value.
+            const uint16_t adcMaxValue14Bit;            ///< Maximum reading of oversampled input used for 14-bit MIDI values.
             const uint16_t stepDiff7Bit;                ///< Minimum difference between two raw ADC readings to consider that value has been changed for 7-bit MIDI values.
-            const uint16_t stepDiff14Bit;               ///< Minimum difference between two raw ADC readings to consider that value has been changed for 14-bit MIDI values.
-            const uint16_t stepDiffDirChange;           ///< Same as stepDiff7Bit and stepDiff14Bit, only used when the direction is different from the last one.
+            const uint16_t stepDiff14Bit;               ///< Minimum difference between two oversampled readings to consider that value has been changed for 14-bit MIDI values.
+            const uint16_t stepDiffDirChange;           ///< Same as stepDiff7Bit, only used when the direction is different from the last one.
+            const uint16_t stepDiffDirChange14Bit;      ///< Same as stepDiff14Bit, only used when the direction is different from the last one.
             const uint16_t fsrMinValue;                 ///< Minimum raw ADC reading for FSR sensors.
             const uint16_t fsrMaxValue;                 ///< Maximum raw ADC reading for FSR sensors.
             const uint16_t aftertouchMaxValue;          ///< Maxmimum raw ADC reading for aftertouch on FSR sensors.
@@ -218,18 +450,13 @@ namespace IO
             const uint16_t digitalValueThresholdOff;    ///< Value below which button connected to analog input is considered released.
         };
 
-        enum class valDirection_t : uint8_t
-        {
-            initial,
-            decreasing,
-            increasing
-        };
-
         adcConfig_t adc10bit = {
             .adcMaxValue              = 1023,
+            .adcMaxValue14Bit         = 1023 * 16,
             .stepDiff7Bit             = 6,
-            .stepDiff14Bit            = 1,
+            .stepDiff14Bit            = 8,
             .stepDiffDirChange        = 6,
+            .stepDiffDirChange14Bit   = 16,
             .fsrMinValue              = 40,
             .fsrMaxValue              = 340,
             .aftertouchMaxValue       = 600,
@@ -239,9 +466,11 @@ namespace IO
 
         adcConfig_t adc12bit = {
             .adcMaxValue              = 4095,
+            .adcMaxValue14Bit         = 4095 * 4,
             .stepDiff7Bit             = 24,
-            .stepDiff14Bit            = 2,
+            .stepDiff14Bit            = 3,
             .stepDiffDirChange        = 24,
+            .stepDiffDirChange14Bit   = 8,
             .fsrMinValue              = 160,
             .fsrMaxValue              = 1360,
             .aftertouchMaxValue       = 2400,
@@ -252,13 +481,18 @@ namespace IO
         const IO::Analog::Filter::adcType_t _adcType;
         adcConfig_t&                        _adcConfig;
         const size_t                        _stableValueRepetitions;
-        const uint32_t                      _fastFilterEnableAfter = 500;
-        EMA                                 _emaFilter[MAX_NUMBER_OF_ANALOG];
-        uint16_t                            _analogSample[MAX_NUMBER_OF_ANALOG][3]   = {};
-        size_t                              _sampleCounter[MAX_NUMBER_OF_ANALOG]     = {};
-        valDirection_t                      _lastDirection[MAX_NUMBER_OF_ANALOG]     = {};
-        uint16_t                            _lastStableValue[MAX_NUMBER_OF_ANALOG]   = {};
-        uint8_t                             _stableSampleCount[MAX_NUMBER_OF_ANALOG] = {};
-        uint32_t                            _lastMovementTime[MAX_NUMBER_OF_ANALOG]  = {};
+        const filterMode_t                  _filterMode;
+        const uint32_t                      _scale7Bit;
+        const uint32_t                      _scale14Bit;
+        const uint32_t                      _scaleFSR;
+        const uint32_t                      _scaleAftertouch;
+        const uint16_t                      _fastFilterEnableAfter = 500;
+        channelState_t                      _state[MAX_NUMBER_OF_ANALOG];
+
+        ///
+        /// \brief Calibrated noise threshold in raw ADC units for each channel.
+        /// Kept separate from channel state so that the state stays compact.
+        ///
+        uint8_t _noiseThreshold[MAX_NUMBER_OF_ANALOG] = {};
     };    // namespace IO
 }    // namespace IO
\ No newline at end of file
@@ -21,19 +21,23 @@ limitations under the License.
 
 using namespace IO;
 
-void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32_t value)
+///
+/// \brief Reads MIDI ID, channel, limits, inversion state and response curve of specified analog component
+/// from database and precomputes the parameters used to scale and send its value.
+/// Should be called whenever any of these parameters or the component type change.
+///
+void Analog::updateScaling(uint16_t index)
 {
-    uint16_t maxLimit;
-
-    uint16_t             lowerLimit = database.read(Database::Section::analog_t::lowerLimit, analogID);
-    uint16_t             upperLimit = database.read(Database::Section::analog_t::upperLimit, analogID);
-    uint16_t             midiID     = database.read(Database::Section::analog_t::midiID, analogID);
-    uint8_t              channel    = database.read(Database::Section::analog_t::midiChannel, analogID);
+    auto                 type       = static_cast<type_t>(database.read(Database::Section::analog_t::type, index));
+    uint16_t             lowerLimit = database.read(Database::Section::analog_t::lowerLimit, index);
+    uint16_t             upperLimit = database.read(Database::Section::analog_t::upperLimit, index);
+    uint16_t             midiID     = database.read(Database::Section::analog_t::midiID, index);
+    bool                 invert     = database.read(Database::Section::analog_t::invert, index);
+    uint16_t             maxLimit;
     MIDI::encDec_14bit_t encDec_14bit;
 
-    if ((analogType == type_t::nrpn14b) || (analogType == type_t::pitchBend) || (analogType == type_t::cc14bit))
+    if ((type == type_t::nrpn14b) || (type == type_t::pitchBend) || (type == type_t::cc14bit))
     {
-        //14-bit values are already read
         maxLimit = MIDI_14_BIT_VALUE_MAX;
     }
     else
@@ -54,26 +58,53 @@ void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32
         upperLimit = encDec_14bit.low;
     }
 
-    if (value > maxLimit)
-        return;
+    auto& descriptor = scaling[index];
 
-    uint32_t scaledMIDIvalue;
+    encDec_14bit.value = midiID;
+    encDec_14bit.split14bit();
 
-    if (lowerLimit > upperLimit)
-    {
-        scaledMIDIvalue = core::misc::mapRange(value, static_cast<uint32_t>(0), static_cast<uint32_t>(maxLimit), static_cast<uint32_t>(upperLimit), static_cast<uint32_t>(lowerLimit));
+    descriptor.midiIDhigh = encDec_14bit.high;
+    descriptor.midiIDlow  = encDec_14bit.low;
+    descriptor.channel    = database.read(Database::Section::analog_t::midiChannel, index);
+    descriptor.curve      = static_cast<AnalogCurve::curve_t>(database.read(Database::Section::analog_t::curve, index));
+
+    //swapped limits invert the output as well - inverting it once more cancels that out
+    descriptor.offset     = invert ? upperLimit : lowerLimit;
+    descriptor.decreasing = (lowerLimit > upperLimit) != invert;
 
-        if (!database.read(Database::Section::analog_t::invert, analogID))
-            scaledMIDIvalue = upperLimit - (scaledMIDIvalue - lowerLimit);
+    //rounded up so that the maximum input always results in exactly the other limit
+    //exact for 7-bit values, within a single step for 14-bit ones
+    uint32_t span     = lowerLimit > upperLimit ? lowerLimit - upperLimit : upperLimit - lowerLimit;
+    descriptor.factor = ((span << 16) + maxLimit - 1) / maxLimit;
+}
+
+void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32_t value)
+{
+    uint16_t maxLimit;
+    bool     use14bit = (analogType == type_t::nrpn14b) || (analogType == type_t::pitchBend) || (analogType == type_t::cc14bit);
+
+    if (use14bit)
+    {
+        //14-bit values are already read
+        maxLimit = MIDI_14_BIT_VALUE_MAX;
     }
     else
     {
-        scaledMIDIvalue = core::misc::mapRange(value, static_cast<uint32_t>(0), static_cast<uint32_t>(maxLimit), static_cast<uint32_t>(lowerLimit), static_cast<uint32_t>(upperLimit));
-
-        if (database.read(Database::Section::analog_t::invert, analogID))
-            scaledMIDIvalue = upperLimit - (scaledMIDIvalue - lowerLimit);
+        maxLimit = MIDI_7_BIT_VALUE_MAX;
     }
 
+    if (value > maxLimit)
+        return;
+
+    auto& descriptor = scaling[analogID];
+
+    value = AnalogCurve::apply(descriptor.curve, value, use14bit);
+
+    uint32_t step            = (value * descriptor.factor) >> 16;
+    uint32_t scaledMIDIvalue = descriptor.decreasing ? descriptor.offset - step : descriptor.offset + step;
+    uint8_t  midiID          = descriptor.midiIDlow;
+    uint8_t  channel         = descriptor.channel;
+
     if (scaledMIDIvalue == lastValue[analogID])
         return;
 
@@ -100,14 +131,10 @@ void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32
     case type_t::cc14bit:
         //when nrpn/cc14bit is used, MIDI ID is split into two messages
         //first message contains higher byte
-
-        encDec_14bit.value = midiID;
-        encDec_14bit.split14bit();
-
         if (analogType != type_t::cc14bit)
         {
-            midi.sendControlChange(99, encDec_14bit.high, channel);
-            midi.sendControlChange(98, encDec_14bit.low, channel);
+            midi.sendControlChange(99, descriptor.midiIDhigh, channel);
+            midi.sendControlChange(98, descriptor.midiIDlow, channel);
         }
 
         if (analogType == type_t::nrpn7b)
@@ -116,7 +143,7 @@ void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32
         }
         else
         {
-            midiID = encDec_14bit.low;
+            MIDI::encDec_14bit_t encDec_14bit;
 
             //send 14-bit value in another two messages
             //first message contains higher byte
@@ -143,7 +170,7 @@ void Analog::checkPotentiometerValue(type_t analogType, uint8_t analogID, uint32
 
     case type_t::pitchBend:
         midi.sendPitchBend(scaledMIDIvalue, channel);
-        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::pitchBend, midiID, scaledMIDIvalue, channel + 1);
+        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::pitchBend, (descriptor.midiIDhigh << 7) | midiID, scaledMIDIvalue, channel + 1);
         break;
 
     default:
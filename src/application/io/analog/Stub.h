@@ -61,10 +61,18 @@ namespace IO
             AMOUNT
         };
 
-        enum class pressureType_t : uint8_t
+        enum class aftertouchType_t : uint8_t
         {
-            velocity,
-            aftertouch
+            none,
+            channel,
+            poly,
+            AMOUNT
+        };
+
+        enum class setting_t : uint8_t
+        {
+            aftertouchRate,
+            AMOUNT
         };
 
         class HWA
@@ -76,10 +84,18 @@ namespace IO
         Analog(HWA& hwa, adcType_t adcType, Database& database, MIDI& midi, IO::LEDs& leds, Display& display, ComponentInfo& cInfo)
         {}
 
+        void init()
+        {
+        }
+
         void update()
         {
         }
 
+        void updateScanState(uint16_t index)
+        {
+        }
+
         void debounceReset(uint16_t index)
         {
         }
@@ -22,375 +22,630 @@ limitations under the License.
 
 using namespace IO;
 
+const Buttons::messageDescriptor_t Buttons::messageDescriptor[static_cast<uint8_t>(Buttons::messageType_t::AMOUNT)] = {
+    //note
+    { &Buttons::sendNote, type_t::AMOUNT },
+    //programChange
+    { &Buttons::sendProgramChange, type_t::momentary },
+    //controlChange
+    { &Buttons::sendControlChange, type_t::momentary },
+    //controlChangeReset
+    { &Buttons::sendControlChange, type_t::AMOUNT },
+    //mmcStop
+    { &Buttons::sendMMC, type_t::momentary },
+    //mmcPlay
+    { &Buttons::sendMMC, type_t::momentary },
+    //mmcRecord
+    { &Buttons::sendMMC, type_t::latching },
+    //mmcPause
+    { &Buttons::sendMMC, type_t::momentary },
+    //realTimeClock
+    { &Buttons::sendRealTime, type_t::momentary },
+    //realTimeStart
+    { &Buttons::sendRealTime, type_t::momentary },
+    //realTimeContinue
+    { &Buttons::sendRealTime, type_t::momentary },
+    //realTimeStop
+    { &Buttons::sendRealTime, type_t::momentary },
+    //realTimeActiveSensing
+    { &Buttons::sendRealTime, type_t::momentary },
+    //realTimeSystemReset
+    { &Buttons::sendRealTime, type_t::momentary },
+    //programChangeInc
+    { &Buttons::sendProgramChangeIncDec, type_t::momentary },
+    //programChangeDec
+    { &Buttons::sendProgramChangeIncDec, type_t::momentary },
+    //none
+    { nullptr, type_t::momentary },
+    //presetOpenDeck
+    { &Buttons::changePreset, type_t::momentary },
+    //multiValIncResetNote
+    { &Buttons::sendMultiValNote, type_t::momentary },
+    //multiValIncDecNote
+    { &Buttons::sendMultiValNote, type_t::momentary },
+    //multiValIncResetCC
+    { &Buttons::sendMultiValCC, type_t::momentary },
+    //multiValIncDecCC
+    { &Buttons::sendMultiValCC, type_t::momentary },
+};
+
+///
+/// \brief Resolves configuration of all buttons from database.
+/// Needs to be called once the database is initialized and on each preset change.
+///
+void Buttons::init()
+{
+    updateGestureTimes();
+
+    //pending gestures have been started with previous configuration (ie. before preset change)
+    gestureTimers.reset();
+
+    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+    {
+        gestureState[i] = 0;
+        buildAction(i);
+    }
+}
+
 ///
 /// \brief Continuously reads inputs from buttons and acts if necessary.
+/// All state changes from single reading are processed as a batch: MIDI messages
+/// are sent back-to-back and LEDs, display and component info are updated afterwards,
+/// so that simultaneously pressed buttons reach the host with minimal delay between them.
 ///
 void Buttons::update()
 {
+    uint32_t time = hwa.stateTime();
+    uint16_t tick = gestureTick(time);
+
+    batchActive = true;
+
+    //gestures which are due before current reading are handled first
+    gestureTimers.advance(tick, [this, tick](size_t buttonID) {
+        onGestureTimer(buttonID, tick);
+    });
+
     for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
     {
         bool state;
 
-        if (!filter.isFiltered(i, hwa.state(i), state))
+        if (!filter.isFiltered(i, hwa.state(i), time, action[i].debounceTime, action[i].debounceMode, state))
             continue;
 
-        processButton(i, state);
+        processButton(i, state, time);
     }
+
+    batchActive = false;
+
+    indicate();
 }
 
 ///
-/// \brief Handles changes in button states.
+/// \brief Handles changes in button states using current time as the time of the change.
+/// Used for buttons which aren't read through HWA (analog and touchscreen buttons).
+/// Current time is taken from HWA so that all buttons share the same clock.
 /// @param [in] buttonID    Button index which has changed state.
 /// @param [in] state       Current button state.
 ///
 void Buttons::processButton(uint8_t buttonID, bool state)
+{
+    processButton(buttonID, state, hwa.currentTime());
+}
+
+///
+/// \brief Handles changes in button states.
+/// @param [in] buttonID    Button index which has changed state.
+/// @param [in] state       Current button state.
+/// @param [in] time        Time in microseconds at which the state has been read.
+///
+void Buttons::processButton(uint8_t buttonID, bool state, uint32_t time)
 {
     //act on change of state only
     if (state == getButtonState(buttonID))
         return;
 
     setButtonState(buttonID, state);
+    stateChangeTime[buttonID] = time;
 
-    auto buttonMessage = static_cast<messageType_t>(database.read(Database::Section::button_t::midiMessage, buttonID));
+    const auto& buttonAction  = action[buttonID];
+    bool        physicalState = state;
+    bool        send          = true;
 
-    //don't process messageType_t::none type of message
-    if (buttonMessage != messageType_t::none)
+    if (buttonAction.type == type_t::latching)
     {
-        auto type = static_cast<type_t>(database.read(Database::Section::button_t::type, buttonID));
-
-        bool sendMIDI = true;
-
-        //overwrite type under certain conditions
-        switch (buttonMessage)
+        //act on press only
+        if (state)
         {
-        case messageType_t::programChange:
-        case messageType_t::programChangeInc:
-        case messageType_t::programChangeDec:
-        case messageType_t::mmcPlay:
-        case messageType_t::mmcStop:
-        case messageType_t::mmcPause:
-        case messageType_t::controlChange:
-        case messageType_t::realTimeClock:
-        case messageType_t::realTimeStart:
-        case messageType_t::realTimeContinue:
-        case messageType_t::realTimeStop:
-        case messageType_t::realTimeActiveSensing:
-        case messageType_t::realTimeSystemReset:
-        case messageType_t::multiValIncResetNote:
-        case messageType_t::multiValIncDecNote:
-        case messageType_t::multiValIncResetCC:
-        case messageType_t::multiValIncDecCC:
-            type = type_t::momentary;
-            break;
-
-        case messageType_t::mmcRecord:
-            type = type_t::latching;
-            break;
-
-        case messageType_t::presetOpenDeck:
-            type     = type_t::momentary;
-            sendMIDI = false;
-            break;
-
-        default:
-            break;
+            //overwrite before processing
+            state = !getLatchingState(buttonID);
+            setLatchingState(buttonID, state);
         }
-
-        if (type == type_t::latching)
+        else
         {
-            //act on press only
-            if (state)
-            {
-                if (getLatchingState(buttonID))
-                {
-                    setLatchingState(buttonID, false);
-                    //overwrite before processing
-                    state = false;
-                }
-                else
-                {
-                    setLatchingState(buttonID, true);
-                    state = true;
-                }
-            }
-            else
-            {
-                sendMIDI = false;
-            }
+            send = false;
         }
+    }
 
-        if (sendMIDI)
-        {
-            sendMessage(buttonID, state, buttonMessage);
-        }
-        else if (buttonMessage == messageType_t::presetOpenDeck)
-        {
-            //change preset only on press
-            if (state)
-            {
-                uint8_t preset = database.read(Database::Section::button_t::midiID, buttonID);
-                database.setPreset(preset);
-            }
-        }
+    if (send)
+        sendAction(buttonID, state, buttonAction);
+    else
+        nextIndication(buttonID);
+
+    if (buttonAction.longPress || buttonAction.doubleTap || buttonAction.repeat)
+        processGesture(buttonID, physicalState, time);
+
+    if (!batchActive)
+        indicate();
+}
+
+///
+/// \brief Reads configuration of specified button from database and resolves the action
+/// which is performed on its state changes.
+/// Needs to be called each time any setting of the button is changed.
+/// @param [in] buttonID    Button for which to build the action.
+///
+void Buttons::buildAction(uint8_t buttonID)
+{
+    auto& buttonAction = action[buttonID];
+
+    buttonAction.message      = static_cast<messageType_t>(database.read(Database::Section::button_t::midiMessage, buttonID));
+    buttonAction.midiID       = database.read(Database::Section::button_t::midiID, buttonID);
+    buttonAction.channel      = database.read(Database::Section::button_t::midiChannel, buttonID);
+    buttonAction.velocity     = database.read(Database::Section::button_t::velocity, buttonID);
+    buttonAction.debounceTime = database.read(Database::Section::button_t::debounceTime, buttonID) * BUTTONS_DEBOUNCE_TIME_UNIT_US;
+    buttonAction.debounceMode = static_cast<debounceMode_t>(database.read(Database::Section::button_t::debounceMode, buttonID));
+
+    buttonAction.longPress       = database.read(Database::Section::button_t::longPress, buttonID);
+    buttonAction.longPressMIDIid = database.read(Database::Section::button_t::longPressMIDIid, buttonID);
+    buttonAction.doubleTap       = database.read(Database::Section::button_t::doubleTap, buttonID);
+    buttonAction.doubleTapMIDIid = database.read(Database::Section::button_t::doubleTapMIDIid, buttonID);
+    buttonAction.repeat          = database.read(Database::Section::button_t::repeat, buttonID);
+
+    if (buttonAction.message >= messageType_t::AMOUNT)
+        buttonAction.message = messageType_t::none;
+
+    //overwrite type under certain conditions
+    buttonAction.type = messageDescriptor[static_cast<uint8_t>(buttonAction.message)].type;
+
+    if (buttonAction.type == type_t::AMOUNT)
+        buttonAction.type = static_cast<type_t>(database.read(Database::Section::button_t::type, buttonID));
+
+    //repeated presses make sense only for momentary buttons
+    if (buttonAction.type != type_t::momentary)
+        buttonAction.repeat = false;
+}
+
+///
+/// \brief Reads gesture times from database.
+/// Needs to be called each time any of the global button settings is changed.
+///
+void Buttons::updateGestureTimes()
+{
+    for (int i = 0; i < static_cast<uint8_t>(setting_t::AMOUNT); i++)
+    {
+        gestureTime[i] = database.read(Database::Section::button_t::global, i) * (BUTTONS_GESTURE_TIME_UNIT_MS / BUTTONS_GESTURE_TICK_MS);
+
+        //timers need to expire in the future
+        if (!gestureTime[i])
+            gestureTime[i] = 1;
     }
+}
+
+///
+/// \brief Sends MIDI message for the specified action and stores its side effects in current batch.
+/// @param [in] buttonID    Button index for which the message is sent.
+/// @param [in] state       Button state passed to message handler.
+/// @param [in] action      Action which should be performed.
+///
+void Buttons::sendAction(uint8_t buttonID, bool state, const action_t& action)
+{
+    auto  handler          = messageDescriptor[static_cast<uint8_t>(action.message)].handler;
+    auto& buttonIndication = nextIndication(buttonID);
+
+    if (handler != nullptr)
+        (this->*handler)(buttonID, state, action, buttonIndication);
+}
+
+///
+/// \brief Sends MIDI message configured for the button with gesture MIDI ID instead of the regular one.
+/// Gestures are always sent as momentary: press once the gesture is detected and release
+/// once the button is released.
+///
+void Buttons::sendGesture(uint8_t buttonID, bool state, uint8_t midiID)
+{
+    auto gestureAction = action[buttonID];
 
-    cInfo.send(Database::block_t::buttons, buttonID);
+    gestureAction.midiID = midiID;
+    sendAction(buttonID, state, gestureAction);
 }
 
 ///
-/// \brief Used to send MIDI message from specified button.
-/// Used internally once the button state has been changed and processed.
-/// @param [in] buttonID        Button ID which sends the message.
-/// @param [in] state           Button state (true/pressed, false/released).
-/// @param [in] buttonMessage   Type of MIDI message to send. If unspecified, message type is read from database.
+/// \brief Returns cleared entry in current batch for side effects of the specified button.
+/// Side effects of the batch are performed first if the batch is full.
 ///
-void Buttons::sendMessage(uint8_t buttonID, bool state, messageType_t buttonMessage)
+Buttons::indication_t& Buttons::nextIndication(uint8_t buttonID)
 {
-    uint8_t note     = database.read(Database::Section::button_t::midiID, buttonID);
-    uint8_t channel  = database.read(Database::Section::button_t::midiChannel, buttonID);
-    uint8_t velocity = database.read(Database::Section::button_t::velocity, buttonID);
+    if (indicationCount == BUTTONS_MAX_BATCH_SIZE)
+        indicate();
+
+    auto& buttonIndication = indication[indicationCount++];
 
-    if (buttonMessage == messageType_t::AMOUNT)
-        buttonMessage = static_cast<messageType_t>(database.read(Database::Section::button_t::midiMessage, buttonID));
+    buttonIndication          = {};
+    buttonIndication.buttonID = buttonID;
 
-    mmcArray[2] = note;    //use midi note as channel id for transport control
+    return buttonIndication;
+}
 
-    bool send = true;
+///
+/// \brief Detects long press, double tap and hold-repeat gestures from button state changes.
+/// Regular press and release messages are sent as usual, gestures send additional messages.
+/// Timed part of the gestures is handled in onGestureTimer.
+/// @param [in] buttonID    Button index which has changed state.
+/// @param [in] state       Current button state.
+/// @param [in] time        Time in microseconds at which the state has been read.
+///
+void Buttons::processGesture(uint8_t buttonID, bool state, uint32_t time)
+{
+    const auto& buttonAction = action[buttonID];
+    uint16_t    tick         = gestureTick(time);
 
     if (state)
     {
-        switch (buttonMessage)
+        if (buttonAction.doubleTap && getGestureState(buttonID, gestureState_t::tapPending))
         {
-        case messageType_t::note:
-        {
-            midi.sendNoteOn(note, velocity, channel);
-#ifdef DISPLAY_SUPPORTED
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOn, note, velocity, channel + 1);
-#endif
-            leds.midiToState(MIDI::messageType_t::noteOn, note, velocity, channel, true);
+            setGestureState(buttonID, gestureState_t::tapPending, false);
+            setGestureState(buttonID, gestureState_t::doubleTap, true);
+            sendGesture(buttonID, true, buttonAction.doubleTapMIDIid);
         }
-        break;
 
-        case messageType_t::programChange:
-        case messageType_t::programChangeInc:
-        case messageType_t::programChangeDec:
-        {
-            if (buttonMessage != messageType_t::programChange)
-            {
-                if (buttonMessage == messageType_t::programChangeInc)
-                {
-                    if (!Common::pcIncrement(channel))
-                        send = false;
-                }
-                else
-                {
-                    if (!Common::pcDecrement(channel))
-                        send = false;
-                }
-
-                note = Common::program(channel);
-            }
-
-            if (send)
-            {
-                midi.sendProgramChange(note, channel);
-                leds.midiToState(MIDI::messageType_t::programChange, note, 0, channel, true);
-#ifdef DISPLAY_SUPPORTED
-                display.displayMIDIevent(Display::eventType_t::out, Display::event_t::programChange, note, 0, channel + 1);
-#endif
-            }
-        }
-        break;
+        if (buttonAction.longPress || buttonAction.repeat)
+            gestureTimers.start(buttonID, tick + gestureTime[static_cast<uint8_t>(setting_t::longPressTime)]);
+        else
+            gestureTimers.stop(buttonID);
+    }
+    else
+    {
+        gestureTimers.stop(buttonID);
 
-        case messageType_t::controlChange:
-        case messageType_t::controlChangeReset:
-        {
-            midi.sendControlChange(note, velocity, channel);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, note, velocity, channel + 1);
-            leds.midiToState(MIDI::messageType_t::controlChange, note, velocity, channel, true);
-        }
-        break;
+        bool held = getGestureState(buttonID, gestureState_t::held);
 
-        case messageType_t::mmcPlay:
-        {
-            mmcArray[4] = 0x02;
-            midi.sendSysEx(6, mmcArray, true);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::mmcPlay, mmcArray[2], 0, 0);
-        }
-        break;
+        setGestureState(buttonID, gestureState_t::held, false);
 
-        case messageType_t::mmcStop:
-        {
-            mmcArray[4] = 0x01;
-            midi.sendSysEx(6, mmcArray, true);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::mmcStop, mmcArray[2], 0, 0);
-        }
-        break;
+        if (held && buttonAction.longPress)
+            sendGesture(buttonID, false, buttonAction.longPressMIDIid);
 
-        case messageType_t::mmcPause:
+        if (getGestureState(buttonID, gestureState_t::doubleTap))
         {
-            mmcArray[4] = 0x09;
-            midi.sendSysEx(6, mmcArray, true);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::mmcPause, mmcArray[2], 0, 0);
+            setGestureState(buttonID, gestureState_t::doubleTap, false);
+            sendGesture(buttonID, false, buttonAction.doubleTapMIDIid);
         }
-        break;
-
-        case messageType_t::realTimeClock:
+        else if (buttonAction.doubleTap && !held)
         {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeClock);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeClock, 0, 0, 0);
+            //only short press can be the first tap
+            setGestureState(buttonID, gestureState_t::tapPending, true);
+            gestureTimers.start(buttonID, tick + gestureTime[static_cast<uint8_t>(setting_t::doubleTapTime)]);
         }
-        break;
+    }
+}
 
-        case messageType_t::realTimeStart:
-        {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeStart);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeStart, 0, 0, 0);
-        }
-        break;
+///
+/// \brief Handles expired gesture timer.
+/// While the button is pressed, timer marks the long press and each auto-repeat.
+/// Once released, it marks the end of double tap window.
+/// @param [in] buttonID    Button index for which the timer has expired.
+/// @param [in] tick        Current gesture tick.
+///
+void Buttons::onGestureTimer(uint8_t buttonID, uint16_t tick)
+{
+    const auto& buttonAction = action[buttonID];
 
-        case messageType_t::realTimeContinue:
-        {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeContinue);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeContinue, 0, 0, 0);
-        }
-        break;
+    if (!getButtonState(buttonID))
+    {
+        setGestureState(buttonID, gestureState_t::tapPending, false);
+        return;
+    }
 
-        case messageType_t::realTimeStop:
-        {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeStop);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeStop, 0, 0, 0);
-        }
-        break;
+    if (!getGestureState(buttonID, gestureState_t::held))
+    {
+        setGestureState(buttonID, gestureState_t::held, true);
 
-        case messageType_t::realTimeActiveSensing:
-        {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeActiveSensing);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeActiveSensing, 0, 0, 0);
-        }
-        break;
+        if (buttonAction.longPress)
+            sendGesture(buttonID, true, buttonAction.longPressMIDIid);
+    }
 
-        case messageType_t::realTimeSystemReset:
-        {
-            midi.sendRealTime(MIDI::messageType_t::sysRealTimeSystemReset);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::sysRealTimeSystemReset, 0, 0, 0);
-        }
-        break;
+    if (buttonAction.repeat)
+    {
+        //repeat is the same as releasing and pressing the button again
+        sendAction(buttonID, false, buttonAction);
+        sendAction(buttonID, true, buttonAction);
+        gestureTimers.start(buttonID, tick + gestureTime[static_cast<uint8_t>(setting_t::repeatTime)]);
+    }
+}
 
-        case messageType_t::mmcRecord:
-        {
-            //start recording
-            mmcArray[4] = 0x06;
-            midi.sendSysEx(6, mmcArray, true);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::mmcRecordOn, mmcArray[2], 0, 0);
-        }
-        break;
+///
+/// \brief Advances gesture clock to specified time and returns current gesture tick.
+/// Gesture clock is advanced only forward: times older than the last one
+/// return current tick.
+/// @param [in] time    Time in microseconds.
+///
+uint16_t Buttons::gestureTick(uint32_t time)
+{
+    int32_t elapsed = time - gestureClockTime;
 
-        case messageType_t::multiValIncResetNote:
-        {
-            uint8_t currentValue = Common::currentValue(buttonID);
-            uint8_t value        = Common::valueInc(buttonID, velocity, Common::incDecType_t::reset);
-
-            if (currentValue != value)
-            {
-                if (!value)
-                {
-                    midi.sendNoteOff(note, value, channel);
-                    leds.midiToState(MIDI::messageType_t::noteOff, note, value, channel, true);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOff, note, value, channel + 1);
-                }
-                else
-                {
-                    midi.sendNoteOn(note, value, channel);
-                    leds.midiToState(MIDI::messageType_t::noteOn, note, value, channel, true);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOn, note, value, channel + 1);
-                }
-            }
-        }
-        break;
+    if (elapsed >= (BUTTONS_GESTURE_TICK_MS * 1000))
+    {
+        uint32_t ticks = elapsed / (BUTTONS_GESTURE_TICK_MS * 1000);
 
-        case messageType_t::multiValIncDecNote:
-        {
-            uint8_t currentValue = Common::currentValue(buttonID);
-            uint8_t value        = Common::valueIncDec(buttonID, velocity);
-
-            if (currentValue != value)
-            {
-                if (!value)
-                {
-                    midi.sendNoteOff(note, value, channel);
-                    leds.midiToState(MIDI::messageType_t::noteOff, note, value, channel, true);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOff, note, value, channel + 1);
-                }
-                else
-                {
-                    midi.sendNoteOn(note, value, channel);
-                    leds.midiToState(MIDI::messageType_t::noteOn, note, value, channel, true);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::noteOn, note, value, channel + 1);
-                }
-            }
-        }
-        break;
+        gestureClock     += ticks;
+        gestureClockTime += ticks * (BUTTONS_GESTURE_TICK_MS * 1000);
+    }
 
-        case messageType_t::multiValIncResetCC:
-        {
-            uint8_t currentValue = Common::currentValue(buttonID);
-            uint8_t value        = Common::valueInc(buttonID, velocity, Common::incDecType_t::reset);
-
-            if (currentValue != value)
-            {
-                midi.sendControlChange(note, value, channel);
-                leds.midiToState(MIDI::messageType_t::controlChange, note, value, channel, true);
-                display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, note, value, channel + 1);
-            }
-        }
-        break;
+    return gestureClock;
+}
 
-        case messageType_t::multiValIncDecCC:
-        {
-            uint8_t currentValue = Common::currentValue(buttonID);
-            uint8_t value        = Common::valueIncDec(buttonID, velocity);
-
-            if (currentValue != value)
-            {
-                midi.sendControlChange(note, value, channel);
-                leds.midiToState(MIDI::messageType_t::controlChange, note, value, channel, true);
-                display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, note, value, channel + 1);
-            }
-        }
-        break;
+///
+/// \brief Checks single gesture state of the specified button.
+///
+bool Buttons::getGestureState(uint8_t buttonID, gestureState_t state)
+{
+    return BIT_READ(gestureState[buttonID], static_cast<uint8_t>(state));
+}
 
-        default:
-            break;
-        }
+///
+/// \brief Updates single gesture state of the specified button.
+///
+void Buttons::setGestureState(uint8_t buttonID, gestureState_t state, bool value)
+{
+    BIT_WRITE(gestureState[buttonID], static_cast<uint8_t>(state), value);
+}
+
+///
+/// \brief Sends note on when the button is pressed and note off when it's released.
+///
+void Buttons::sendNote(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (state)
+    {
+        midi.sendNoteOn(action.midiID, action.velocity, action.channel);
+        indicateMIDI(indication, MIDI::messageType_t::noteOn, Display::event_t::noteOn, action.midiID, action.velocity, action.channel);
+    }
+    else
+    {
+        midi.sendNoteOff(action.midiID, 0, action.channel);
+        indicateMIDI(indication, MIDI::messageType_t::noteOff, midi.getNoteOffMode() == MIDI::noteOffType_t::standardNoteOff ? Display::event_t::noteOff : Display::event_t::noteOn, action.midiID, 0, action.channel);
+    }
+}
+
+///
+/// \brief Sends program change with configured program on press.
+///
+void Buttons::sendProgramChange(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (!state)
+        return;
+
+    midi.sendProgramChange(action.midiID, action.channel);
+    indicateMIDI(indication, MIDI::messageType_t::programChange, Display::event_t::programChange, action.midiID, 0, action.channel);
+}
+
+///
+/// \brief Increments or decrements the current program on the channel on press and sends it.
+///
+void Buttons::sendProgramChangeIncDec(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (!state)
+        return;
+
+    if (action.message == messageType_t::programChangeInc)
+    {
+        if (!Common::pcIncrement(action.channel))
+            return;
+    }
+    else
+    {
+        if (!Common::pcDecrement(action.channel))
+            return;
+    }
+
+    uint8_t program = Common::program(action.channel);
+
+    midi.sendProgramChange(program, action.channel);
+    indicateMIDI(indication, MIDI::messageType_t::programChange, Display::event_t::programChange, program, 0, action.channel);
+}
+
+///
+/// \brief Sends control change with configured value on press.
+/// Control change with value 0 is sent on release in controlChangeReset mode.
+///
+void Buttons::sendControlChange(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    uint8_t value = action.velocity;
+
+    if (!state)
+    {
+        if (action.message != messageType_t::controlChangeReset)
+            return;
+
+        value = 0;
+    }
+
+    midi.sendControlChange(action.midiID, value, action.channel);
+    indicateMIDI(indication, MIDI::messageType_t::controlChange, Display::event_t::controlChange, action.midiID, value, action.channel);
+}
+
+///
+/// \brief Sends MMC command on press. MIDI ID is used as MMC channel.
+/// Recording is stopped on second press since the type of mmcRecord button is always latching.
+///
+void Buttons::sendMMC(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    //commands and display events in the same order as in messageType_t
+    static const uint8_t          mmcCommand[4] = { 0x01, 0x02, 0x06, 0x09 };
+    static const Display::event_t mmcEvent[4]   = {
+        Display::event_t::mmcStop,
+        Display::event_t::mmcPlay,
+        Display::event_t::mmcRecordOn,
+        Display::event_t::mmcPause,
+    };
+
+    uint8_t index = static_cast<uint8_t>(action.message) - static_cast<uint8_t>(messageType_t::mmcStop);
+    auto    event = mmcEvent[index];
+
+    mmcArray[2] = action.midiID;
+    mmcArray[4] = mmcCommand[index];
+
+    if (!state)
+    {
+        if (action.message != messageType_t::mmcRecord)
+            return;
+
+        //stop recording
+        mmcArray[4] = 0x07;
+        event       = Display::event_t::mmcRecordOff;
+    }
+
+    midi.sendSysEx(6, mmcArray, true);
+    indicateEvent(indication, event, mmcArray[2]);
+}
+
+///
+/// \brief Sends system real-time message on press.
+///
+void Buttons::sendRealTime(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    //messages and display events in the same order as in messageType_t
+    static const MIDI::messageType_t realTimeMessage[6] = {
+        MIDI::messageType_t::sysRealTimeClock,
+        MIDI::messageType_t::sysRealTimeStart,
+        MIDI::messageType_t::sysRealTimeContinue,
+        MIDI::messageType_t::sysRealTimeStop,
+        MIDI::messageType_t::sysRealTimeActiveSensing,
+        MIDI::messageType_t::sysRealTimeSystemReset,
+    };
+
+    static const Display::event_t realTimeEvent[6] = {
+        Display::event_t::sysRealTimeClock,
+        Display::event_t::sysRealTimeStart,
+        Display::event_t::sysRealTimeContinue,
+        Display::event_t::sysRealTimeStop,
+        Display::event_t::sysRealTimeActiveSensing,
+        Display::event_t::sysRealTimeSystemReset,
+    };
+
+    if (!state)
+        return;
+
+    uint8_t index = static_cast<uint8_t>(action.message) - static_cast<uint8_t>(messageType_t::realTimeClock);
+
+    midi.sendRealTime(realTimeMessage[index]);
+    indicateEvent(indication, realTimeEvent[index], 0);
+}
+
+///
+/// \brief Increments (with reset) or increments/decrements the value on press and sends it as note.
+/// Note off is sent once the value reaches 0.
+///
+void Buttons::sendMultiValNote(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (!state)
+        return;
+
+    uint8_t currentValue = Common::currentValue(buttonID);
+    uint8_t value        = action.message == messageType_t::multiValIncResetNote ? Common::valueInc(buttonID, action.velocity, Common::incDecType_t::reset)
+                                                                                 : Common::valueIncDec(buttonID, action.velocity);
+
+    if (currentValue == value)
+        return;
+
+    if (!value)
+    {
+        midi.sendNoteOff(action.midiID, value, action.channel);
+        indicateMIDI(indication, MIDI::messageType_t::noteOff, Display::event_t::noteOff, action.midiID, value, action.channel);
     }
     else
     {
-        switch (buttonMessage)
+        midi.sendNoteOn(action.midiID, value, action.channel);
+        indicateMIDI(indication, MIDI::messageType_t::noteOn, Display::event_t::noteOn, action.midiID, value, action.channel);
+    }
+}
+
+///
+/// \brief Increments (with reset) or increments/decrements the value on press and sends it as control change.
+///
+void Buttons::sendMultiValCC(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (!state)
+        return;
+
+    uint8_t currentValue = Common::currentValue(buttonID);
+    uint8_t value        = action.message == messageType_t::multiValIncResetCC ? Common::valueInc(buttonID, action.velocity, Common::incDecType_t::reset)
+                                                                               : Common::valueIncDec(buttonID, action.velocity);
+
+    if (currentValue == value)
+        return;
+
+    midi.sendControlChange(action.midiID, value, action.channel);
+    indicateMIDI(indication, MIDI::messageType_t::controlChange, Display::event_t::controlChange, action.midiID, value, action.channel);
+}
+
+///
+/// \brief Switches to the preset specified with MIDI ID on press.
+///
+void Buttons::changePreset(uint8_t buttonID, bool state, const action_t& action, indication_t& indication)
+{
+    if (!state)
+        return;
+
+    database.setPreset(action.midiID);
+}
+
+///
+/// \brief Stores LED and display update for sent channel MIDI message.
+///
+void Buttons::indicateMIDI(indication_t& indication, MIDI::messageType_t message, Display::event_t event, uint8_t data1, uint8_t data2, uint8_t channel)
+{
+    indication.midi         = true;
+    indication.display      = true;
+    indication.midiMessage  = message;
+    indication.displayEvent = event;
+    indication.data1        = data1;
+    indication.data2        = data2;
+    indication.channel      = channel;
+}
+
+///
+/// \brief Stores display update for sent message which doesn't affect LEDs (MMC and real-time messages).
+///
+void Buttons::indicateEvent(indication_t& indication, Display::event_t event, uint8_t data1)
+{
+    indication.display      = true;
+    indication.displayEvent = event;
+    indication.data1        = data1;
+}
+
+///
+/// \brief Performs side effects of all button state changes in current batch.
+///
+void Buttons::indicate()
+{
+    for (size_t i = 0; i < indicationCount; i++)
+    {
+        const auto& buttonIndication = indication[i];
+
+        if (buttonIndication.midi)
+            leds.midiToState(buttonIndication.midiMessage, buttonIndication.data1, buttonIndication.data2, buttonIndication.channel, true);
+
+        if (buttonIndication.display)
         {
-        case messageType_t::note:
-            midi.sendNoteOff(note, 0, channel);
-            display.displayMIDIevent(Display::eventType_t::out, midi.getNoteOffMode() == MIDI::noteOffType_t::standardNoteOff ? Display::event_t::noteOff : Display::event_t::noteOn, note, 0, channel + 1);
-            leds.midiToState(MIDI::messageType_t::noteOff, note, 0, channel, true);
-            break;
-
-        case messageType_t::controlChangeReset:
-            midi.sendControlChange(note, 0, channel);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, note, 0, channel + 1);
-            leds.midiToState(MIDI::messageType_t::controlChange, note, 0, channel, true);
-            break;
-
-        case messageType_t::mmcRecord:
-            //stop recording
-            mmcArray[4] = 0x07;
-            midi.sendSysEx(6, mmcArray, true);
-            display.displayMIDIevent(Display::eventType_t::out, Display::event_t::mmcRecordOff, mmcArray[2], 0, 0);
-            break;
-
-        default:
-            break;
+            //channels are displayed starting from 1, messages without channel show 0
+            uint8_t channel = buttonIndication.midi ? buttonIndication.channel + 1 : 0;
+            display.displayMIDIevent(Display::eventType_t::out, buttonIndication.displayEvent, buttonIndication.data1, buttonIndication.data2, channel);
         }
+
+        cInfo.send(Database::block_t::buttons, buttonIndication.buttonID);
     }
+
+    indicationCount = 0;
 }
 
 ///
@@ -419,6 +674,15 @@ bool Buttons::getButtonState(uint8_t buttonID)
     return BIT_READ(buttonPressed[arrayIndex], buttonIndex);
 }
 
+///
+/// \brief Returns time in microseconds at which the specified button has last changed its state.
+/// @param [in] buttonID    Button index for which time is being checked.
+///
+uint32_t Buttons::getStateChangeTime(uint8_t buttonID)
+{
+    return stateChangeTime[buttonID];
+}
+
 ///
 /// \brief Updates current state of latching button.
 /// Used only for latching buttons where new state which should be sent differs
@@ -459,5 +723,8 @@ void Buttons::reset(uint8_t buttonID)
 {
     setButtonState(buttonID, false);
     setLatchingState(buttonID, false);
+    gestureState[buttonID] = 0;
+    gestureTimers.stop(buttonID);
     filter.reset(buttonID);
+    buildAction(buttonID);
 }
\ No newline at end of file
@@ -27,6 +27,8 @@ limitations under the License.
 #include "io/leds/LEDs.h"
 #include "io/display/Display.h"
 #include "io/common/CInfo.h"
+#include "common/TimerWheel/TimerWheel.h"
+#include "Constants.h"
 
 namespace IO
 {
@@ -79,17 +81,60 @@ namespace IO
             AMOUNT
         };
 
+        ///
+        /// \brief List of all possible debounce modes.
+        ///
+        enum class debounceMode_t : uint8_t
+        {
+            stable,    ///< Change is reported once the new state has been stable for the entire debounce time.
+            eager,     ///< Change is reported immediately, further changes are ignored for the debounce time.
+            AMOUNT     ///< Total number of debounce modes.
+        };
+
+        ///
+        /// \brief List of global button settings.
+        /// All times are set in units of BUTTONS_GESTURE_TIME_UNIT_MS.
+        ///
+        enum class setting_t : uint8_t
+        {
+            longPressTime,    ///< Time for which the button needs to be held for long press and auto-repeat.
+            doubleTapTime,    ///< Maximum time between release and next press for double tap.
+            repeatTime,       ///< Auto-repeat interval.
+            AMOUNT            ///< Total number of settings.
+        };
+
         class HWA
         {
             public:
             virtual bool state(size_t index) = 0;
+
+            ///
+            /// \brief Returns time in microseconds at which the states returned by state() have been read.
+            ///
+            virtual uint32_t stateTime() = 0;
+
+            ///
+            /// \brief Returns current time in microseconds, using the same clock as stateTime().
+            /// Used as the time of state changes of buttons which aren't read through HWA.
+            ///
+            virtual uint32_t currentTime() = 0;
         };
 
         class Filter
         {
             public:
-            virtual bool isFiltered(size_t index, bool value, bool& filteredValue) = 0;
-            virtual void reset(size_t index)                                       = 0;
+            ///
+            /// \brief Debounces single button reading.
+            /// @param [in] index               Index of button.
+            /// @param [in] value               Raw button state.
+            /// @param [in] time                Time in microseconds at which the state has been read.
+            /// @param [in] debounceTime        Debounce time in microseconds.
+            /// @param [in] debounceMode        Debounce mode. See debounceMode_t.
+            /// @param [in,out] filteredValue   Debounced state.
+            /// \returns True if the state is debounced, false otherwise.
+            ///
+            virtual bool isFiltered(size_t index, bool value, uint32_t time, uint32_t debounceTime, debounceMode_t debounceMode, bool& filteredValue) = 0;
+            virtual void reset(size_t index)                                                                                                           = 0;
         };
 
         Buttons(HWA&           hwa,
@@ -108,16 +153,99 @@ namespace IO
             , cInfo(cInfo)
         {}
 
-        void update();
-        void processButton(uint8_t buttonID, bool state);
-        bool getButtonState(uint8_t buttonID);
-        void reset(uint8_t buttonID);
+        void     init();
+        void     update();
+        void     processButton(uint8_t buttonID, bool state);
+        void     processButton(uint8_t buttonID, bool state, uint32_t time);
+        bool     getButtonState(uint8_t buttonID);
+        uint32_t getStateChangeTime(uint8_t buttonID);
+        void     reset(uint8_t buttonID);
+        void     buildAction(uint8_t buttonID);
+        void     updateGestureTimes();
 
         private:
-        void sendMessage(uint8_t buttonID, bool state, messageType_t buttonMessage = messageType_t::AMOUNT);
-        void setButtonState(uint8_t buttonID, uint8_t state);
-        void setLatchingState(uint8_t buttonID, uint8_t state);
-        bool getLatchingState(uint8_t buttonID);
+        ///
+        /// \brief Configuration of single button resolved from database.
+        /// Built once the button configuration is loaded or changed so that
+        /// button state changes don't require any database access.
+        ///
+        struct action_t
+        {
+            messageType_t  message;            ///< MIDI message button sends.
+            type_t         type;               ///< Button type once overridden by the message type.
+            uint8_t        midiID;             ///< MIDI ID (note, CC number, program, MMC channel or preset).
+            uint8_t        channel;            ///< MIDI channel.
+            uint8_t        velocity;           ///< Velocity or control value.
+            uint16_t       debounceTime;       ///< Debounce time in microseconds.
+            debounceMode_t debounceMode;       ///< Debounce mode.
+            bool           longPress;          ///< Long press gesture enabled.
+            uint8_t        longPressMIDIid;    ///< MIDI ID sent on long press.
+            bool           doubleTap;          ///< Double tap gesture enabled.
+            uint8_t        doubleTapMIDIid;    ///< MIDI ID sent on double tap.
+            bool           repeat;             ///< Auto-repeat enabled.
+        };
+
+        ///
+        /// \brief List of gesture states stored for each button as bits.
+        ///
+        enum class gestureState_t : uint8_t
+        {
+            held,          ///< Button has been held for the long press time.
+            tapPending,    ///< Button has been released and the next press within double tap time is double tap.
+            doubleTap,     ///< Current press is double tap.
+            AMOUNT         ///< Total number of gesture states.
+        };
+
+        ///
+        /// \brief Side effects of single button state change performed once MIDI messages
+        /// for the entire batch have been sent.
+        ///
+        struct indication_t
+        {
+            uint8_t             buttonID;        ///< Button which has changed state.
+            bool                midi;            ///< True if MIDI message has been sent and LEDs should be updated.
+            bool                display;         ///< True if the event should be shown on display.
+            MIDI::messageType_t midiMessage;     ///< Sent MIDI message.
+            Display::event_t    displayEvent;    ///< Display event.
+            uint8_t             data1;           ///< First data byte of sent message.
+            uint8_t             data2;           ///< Second data byte of sent message.
+            uint8_t             channel;         ///< MIDI channel of sent message.
+        };
+
+        using messageHandler_t = void (Buttons::*)(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+
+        ///
+        /// \brief Handler and button type used for single MIDI message type.
+        ///
+        struct messageDescriptor_t
+        {
+            messageHandler_t handler;    ///< Function called on state change. Nothing is done if set to nullptr.
+            type_t           type;       ///< Button type enforced by the message. type_t::AMOUNT if type from database should be used.
+        };
+
+        void          sendNote(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendProgramChange(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendProgramChangeIncDec(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendControlChange(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendMMC(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendRealTime(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendMultiValNote(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendMultiValCC(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          changePreset(uint8_t buttonID, bool state, const action_t& action, indication_t& indication);
+        void          sendAction(uint8_t buttonID, bool state, const action_t& action);
+        void          sendGesture(uint8_t buttonID, bool state, uint8_t midiID);
+        indication_t& nextIndication(uint8_t buttonID);
+        void          processGesture(uint8_t buttonID, bool state, uint32_t time);
+        void          onGestureTimer(uint8_t buttonID, uint16_t tick);
+        uint16_t      gestureTick(uint32_t time);
+        bool          getGestureState(uint8_t buttonID, gestureState_t state);
+        void          setGestureState(uint8_t buttonID, gestureState_t state, bool value);
+        void          indicateMIDI(indication_t& indication, MIDI::messageType_t message, Display::event_t event, uint8_t data1, uint8_t data2, uint8_t channel);
+        void          indicateEvent(indication_t& indication, Display::event_t event, uint8_t data1);
+        void          indicate();
+        void          setButtonState(uint8_t buttonID, uint8_t state);
+        void          setLatchingState(uint8_t buttonID, uint8_t state);
+        bool          getLatchingState(uint8_t buttonID);
 
         HWA&           hwa;
         Filter&        filter;
@@ -132,11 +260,67 @@ namespace IO
         ///
         uint8_t buttonPressed[(MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS) / 8 + 1] = {};
 
+        ///
+        /// \brief Array holding time in microseconds of last state change for all buttons.
+        ///
+        uint32_t stateChangeTime[MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS] = {};
+
         ///
         /// \brief Array holding last sent state for latching buttons only.
         ///
         uint8_t lastLatchingState[(MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS) / 8 + 1] = {};
 
+        ///
+        /// \brief Resolved configuration for all buttons.
+        ///
+        action_t action[MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS] = {};
+
+        ///
+        /// \brief Gesture times in gesture ticks. See setting_t.
+        ///
+        uint8_t gestureTime[static_cast<uint8_t>(setting_t::AMOUNT)] = {};
+
+        ///
+        /// \brief Gesture states for all buttons. See gestureState_t.
+        ///
+        uint8_t gestureState[MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS] = {};
+
+        ///
+        /// \brief Pending long press, repeat and double tap timers.
+        /// Each button has at most one pending timer: the hold timer while pressed and
+        /// the double tap timer once released.
+        ///
+        TimerWheel<MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS, BUTTONS_GESTURE_TIMER_SLOTS> gestureTimers;
+
+        ///
+        /// \brief Current gesture tick and the time in microseconds at which it has started.
+        /// Advanced from the time of each button reading.
+        ///
+        uint16_t gestureClock     = 0;
+        uint32_t gestureClockTime = 0;
+
+        ///
+        /// \brief Side effects of button state changes in current batch.
+        ///
+        indication_t indication[BUTTONS_MAX_BATCH_SIZE] = {};
+
+        ///
+        /// \brief Amount of entries stored in indication array.
+        ///
+        size_t indicationCount = 0;
+
+        ///
+        /// \brief True while button states read through HWA are processed.
+        /// Side effects are performed after each button state change otherwise.
+        ///
+        bool batchActive = false;
+
+        ///
+        /// \brief Handler and enforced button type for each MIDI message type.
+        /// Shared by all instances.
+        ///
+        static const messageDescriptor_t messageDescriptor[static_cast<uint8_t>(messageType_t::AMOUNT)];
+
         ///
         /// \brief Array used for simpler building of transport control messages.
         /// Based on MIDI specification for transport control.
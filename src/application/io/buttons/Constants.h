@@ -0,0 +1,83 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+///
+/// \brief Time in microseconds represented by single unit of debounce time setting.
+///
+#define BUTTONS_DEBOUNCE_TIME_UNIT_US 100
+
+///
+/// \brief Default debounce time in units of BUTTONS_DEBOUNCE_TIME_UNIT_US.
+/// Button state is accepted once it has been stable for this long.
+///
+#define BUTTONS_DEFAULT_DEBOUNCE_TIME 15
+
+///
+/// \brief Maximum debounce time in units of BUTTONS_DEBOUNCE_TIME_UNIT_US which can be configured.
+///
+#define BUTTONS_MAX_DEBOUNCE_TIME 127
+
+///
+/// \brief Maximum amount of button state changes processed in single batch.
+/// MIDI messages for all changes in a batch are sent first, after which LEDs,
+/// display and component info are updated for the entire batch.
+///
+#define BUTTONS_MAX_BATCH_SIZE 16
+
+///
+/// \brief Time in milliseconds represented by single unit of gesture time settings
+/// (long press, double tap and repeat time).
+///
+#define BUTTONS_GESTURE_TIME_UNIT_MS 20
+
+///
+/// \brief Maximum gesture time in units of BUTTONS_GESTURE_TIME_UNIT_MS which can be configured.
+///
+#define BUTTONS_MAX_GESTURE_TIME 127
+
+///
+/// \brief Default time in units of BUTTONS_GESTURE_TIME_UNIT_MS for which the button
+/// needs to be held for long press and auto-repeat.
+///
+#define BUTTONS_DEFAULT_LONG_PRESS_TIME 25
+
+///
+/// \brief Default maximum time in units of BUTTONS_GESTURE_TIME_UNIT_MS between
+/// release and next press for double tap.
+///
+#define BUTTONS_DEFAULT_DOUBLE_TAP_TIME 15
+
+///
+/// \brief Default auto-repeat interval in units of BUTTONS_GESTURE_TIME_UNIT_MS.
+///
+#define BUTTONS_DEFAULT_REPEAT_TIME 5
+
+///
+/// \brief Resolution of gesture timers in milliseconds.
+/// BUTTONS_GESTURE_TIME_UNIT_MS must be multiple of this value.
+///
+#define BUTTONS_GESTURE_TICK_MS 10
+
+///
+/// \brief Amount of slots in the timer wheel used for gesture timers.
+/// Timers which expire more than this amount of ticks in the future are checked
+/// once per each round of the wheel.
+///
+#define BUTTONS_GESTURE_TIMER_SLOTS 32
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "io/buttons/Buttons.h"
+#include "core/src/general/Helpers.h"
 
 namespace IO
 {
@@ -27,39 +28,78 @@ namespace IO
         public:
         ButtonsFilter() = default;
 
-        bool isFiltered(size_t index, bool state, bool& filteredState) override
+        bool isFiltered(size_t index, bool state, uint32_t time, uint32_t debounceTime, Buttons::debounceMode_t debounceMode, bool& filteredState) override
         {
-            // Shift old value to the left, append new value and
-            // append DEBOUNCE_COMPARE with OR command. If final value is equal to 0xFF or
-            // DEBOUNCE_COMPARE, signal is debounced.
-            buttonDebounceCounter[index] = (buttonDebounceCounter[index] << (uint8_t)1) | (uint8_t)state | buttonDebounceCompare;
+            uint8_t  arrayIndex  = index / 8;
+            uint8_t  buttonIndex = index - 8 * arrayIndex;
+            uint16_t elapsed     = time - stateChangeTime[index];
 
-            if ((buttonDebounceCounter[index] == buttonDebounceCompare) || (buttonDebounceCounter[index] == 0xFF))
+            if (debounceMode == Buttons::debounceMode_t::eager)
             {
-                filteredState = buttonDebounceCounter[index] == 0xFF;
+                //report the first change immediately and ignore everything else until debounce time passes
+                if (elapsed >= debounceTime)
+                {
+                    if (BIT_READ(lastState[arrayIndex], buttonIndex) != state)
+                    {
+                        BIT_WRITE(lastState[arrayIndex], buttonIndex, state);
+                        stateChangeTime[index] = time;
+                    }
+                    else
+                    {
+                        trail(index, time, debounceTime);
+                    }
+                }
+
+                filteredState = BIT_READ(lastState[arrayIndex], buttonIndex);
                 return true;
             }
 
-            return false;
+            //restart debounce window on each change of raw state
+            if (BIT_READ(lastState[arrayIndex], buttonIndex) != state)
+            {
+                BIT_WRITE(lastState[arrayIndex], buttonIndex, state);
+                stateChangeTime[index] = time;
+                elapsed                = 0;
+            }
+
+            if (elapsed < debounceTime)
+                return false;
+
+            trail(index, time, debounceTime);
+
+            filteredState = state;
+            return true;
         }
 
         void reset(size_t index) override
         {
-            buttonDebounceCounter[index] = 0;
+            uint8_t arrayIndex  = index / 8;
+            uint8_t buttonIndex = index - 8 * arrayIndex;
+
+            BIT_CLEAR(lastState[arrayIndex], buttonIndex);
+            stateChangeTime[index] = 0;
         }
 
         private:
         ///
-        /// \brief Constant used to debounce button readings.
-        /// Once new value has been read, shift old value to the left, append new value and
-        /// append buttonDebounceCompare with OR operator. If final value is equal to 0xFF or
-        /// buttonDebounceCompare, button state is debounced.
+        /// \brief Moves the time of last change so that it's exactly debounce time behind current time.
+        /// Used once debounce time has passed so that the difference between current time and time of
+        /// last change, which is stored in 16 bits only, never wraps around.
+        ///
+        void trail(size_t index, uint32_t time, uint32_t debounceTime)
+        {
+            stateChangeTime[index] = time - debounceTime;
+        }
+
+        ///
+        /// \brief Array holding last state for all buttons.
+        /// In stable mode, this is the last raw state. In eager mode, this is the last reported state.
         ///
-        const uint8_t buttonDebounceCompare = 0b11110000;
+        uint8_t lastState[(MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS) / 8 + 1] = {};
 
         ///
-        /// \brief Array holding debounce count for all buttons to avoid incorrect state detection.
+        /// \brief Array holding lower 16 bits of time in microseconds at which state in lastState has last changed for all buttons.
         ///
-        uint8_t buttonDebounceCounter[MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS] = {};
+        uint16_t stateChangeTime[MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS] = {};
     };
-}    // namespace IO
\ No newline at end of file
+}    // namespace IO
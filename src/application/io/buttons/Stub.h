@@ -24,6 +24,7 @@ limitations under the License.
 #include "io/display/Display.h"
 #include "io/common/Common.h"
 #include "io/common/CInfo.h"
+#include "Constants.h"
 
 namespace IO
 {
@@ -64,17 +65,34 @@ namespace IO
             AMOUNT
         };
 
+        enum class debounceMode_t : uint8_t
+        {
+            stable,
+            eager,
+            AMOUNT
+        };
+
+        enum class setting_t : uint8_t
+        {
+            longPressTime,
+            doubleTapTime,
+            repeatTime,
+            AMOUNT
+        };
+
         class HWA
         {
             public:
-            virtual bool state(size_t index) = 0;
+            virtual bool     state(size_t index) = 0;
+            virtual uint32_t stateTime()         = 0;
+            virtual uint32_t currentTime()       = 0;
         };
 
         class Filter
         {
             public:
-            virtual bool isFiltered(size_t index, bool value, bool& filteredValue) = 0;
-            virtual void reset(size_t index)                                       = 0;
+            virtual bool isFiltered(size_t index, bool value, uint32_t time, uint32_t debounceTime, debounceMode_t debounceMode, bool& filteredValue) = 0;
+            virtual void reset(size_t index)                                                                                                           = 0;
         };
 
         Buttons(HWA&           hwa,
@@ -86,6 +104,10 @@ namespace IO
                 ComponentInfo& cInfo)
         {}
 
+        void init()
+        {
+        }
+
         void update()
         {
         }
@@ -94,13 +116,30 @@ namespace IO
         {
         }
 
+        void processButton(uint8_t buttonID, bool state, uint32_t time)
+        {
+        }
+
         bool getButtonState(uint8_t buttonID)
         {
             return false;
         }
 
+        uint32_t getStateChangeTime(uint8_t buttonID)
+        {
+            return 0;
+        }
+
         void reset(uint8_t buttonID)
         {
         }
+
+        void buildAction(uint8_t buttonID)
+        {
+        }
+
+        void updateGestureTimes()
+        {
+        }
     };
 }    // namespace IO
\ No newline at end of file
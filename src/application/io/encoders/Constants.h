@@ -33,6 +33,30 @@ limitations under the License.
 #define ENCODERS_DEBOUNCE_COUNT 4
 
 ///
-/// \brief Time threshold in milliseconds between two encoder steps used to detect fast movement.
+/// \brief Time in microseconds between two detents after which the encoder is considered stopped
+/// and its speed estimate is reset.
 ///
-#define ENCODERS_SPEED_TIMEOUT 140
\ No newline at end of file
+#define ENCODERS_SPEED_TIMEOUT 140000
+
+///
+/// \brief Average time between detents is updated by 1/(2^ENCODERS_SPEED_SMOOTHING) of
+/// the difference on each detent.
+///
+#define ENCODERS_SPEED_SMOOTHING 2
+
+///
+/// \brief Maximum amount of steps which can be sent in single message in 7-bit relative modes.
+///
+#define ENCODERS_RELATIVE_MAX_STEPS 63
+
+///
+/// \brief Maximum amount of steps which can be sent in single message in 14-bit relative mode.
+///
+#define ENCODERS_RELATIVE_MAX_STEPS_14BIT 8191
+
+///
+/// \brief Time in milliseconds after the last local movement of an encoder during which
+/// remote sync values for that encoder are ignored.
+/// Prevents delayed echoes of values sent while turning the encoder from moving it back.
+///
+#define ENCODERS_REMOTE_SYNC_GRACE_TIME 150
@@ -23,6 +23,10 @@ limitations under the License.
 
 using namespace IO;
 
+constexpr size_t  Encoders::ENCODERS_PER_GROUP;
+constexpr size_t  Encoders::NUMBER_OF_GROUPS;
+constexpr uint8_t Encoders::MAX_READINGS;
+
 ///
 /// \brief Initializes values for all encoders to their defaults.
 ///
@@ -34,202 +38,426 @@ void Encoders::init()
 
 ///
 /// \brief Continuously checks state of all encoders.
+/// All readings available since the last check are decoded at once and
+/// single message with the total amount of steps is sent for each encoder which has moved.
+/// Remote sync values received since the last check are applied afterwards.
 ///
 void Encoders::update()
 {
-    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
-    {
-        if (!database.read(Database::Section::encoder_t::enable, i))
-            continue;
+    uint8_t numberOfReadings = hwa.readings();
 
-        position_t encoderState = read(i, hwa.state(i));
+    if (numberOfReadings > MAX_READINGS)
+        numberOfReadings = MAX_READINGS;
 
-        //disable debounce mode if encoder isn't moving for more than
-        //ENCODERS_DEBOUNCE_RESET_TIME milliseconds
-        if ((core::timing::currentRunTimeMs() - lastMovementTime[i]) > ENCODERS_DEBOUNCE_RESET_TIME)
-        {
-            debounceCounter[i]   = 0;
-            debounceDirection[i] = position_t::stopped;
-        }
+    size_t moved = decode(numberOfReadings);
+
+    for (size_t i = 0; i < moved; i++)
+        process(movedEncoders[i], numberOfReadings);
+
+    applyRemoteSync();
+}
+
+///
+/// \brief Runs the state machine of all encoders over all available readings.
+/// Groups of encoders whose signals haven't changed are skipped with single comparison.
+/// Readings in which steps have been made are stored in stepReadings and stepDirections.
+/// @param [in] numberOfReadings    Amount of readings to decode.
+/// \returns Amount of encoders stored in movedEncoders.
+///
+size_t Encoders::decode(uint8_t numberOfReadings)
+{
+    size_t moved = 0;
 
-        if (encoderState != position_t::stopped)
+    for (uint8_t reading = 0; reading < numberOfReadings; reading++)
+    {
+        for (uint8_t group = 0; group < NUMBER_OF_GROUPS; group++)
         {
-            if (database.read(Database::Section::encoder_t::invert, i))
-            {
-                if (encoderState == position_t::ccw)
-                    encoderState = position_t::cw;
-                else
-                    encoderState = position_t::ccw;
-            }
+            uint8_t state   = hwa.state(reading, group);
+            uint8_t changed = state ^ lastState[group];
 
-            if (debounceCounter[i] != ENCODERS_DEBOUNCE_COUNT)
+            if (!changed && !referenceMissing[group])
+                continue;
+
+            for (uint8_t slot = 0; slot < ENCODERS_PER_GROUP; slot++)
             {
-                if (encoderState != lastDirection[i])
-                    debounceCounter[i] = 0;
+                uint8_t shift = slot * 2;
+
+                if (!((changed >> shift) & 0x03))
+                {
+                    BIT_CLEAR(referenceMissing[group], slot);
+                    continue;
+                }
+
+                uint8_t encoderID = group * ENCODERS_PER_GROUP + slot;
 
-                debounceCounter[i]++;
+                if (encoderID >= MAX_NUMBER_OF_ENCODERS)
+                    break;
 
-                if (debounceCounter[i] == ENCODERS_DEBOUNCE_COUNT)
+                if (BIT_READ(referenceMissing[group], slot))
                 {
-                    debounceCounter[i]   = 0;
-                    debounceDirection[i] = encoderState;
+                    BIT_CLEAR(referenceMissing[group], slot);
+                    continue;
                 }
-            }
 
-            uint8_t encAcceleration = database.read(Database::Section::encoder_t::acceleration, i);
+                auto position = pulse(encoderID, (lastState[group] >> shift) & 0x03, (state >> shift) & 0x03);
 
-            if (encAcceleration)
-            {
-                //when time difference between two movements is smaller than ENCODERS_SPEED_TIMEOUT,
-                //start accelerating
-                if ((core::timing::currentRunTimeMs() - lastMovementTime[i]) < ENCODERS_SPEED_TIMEOUT)
-                    encoderSpeed[i] = CONSTRAIN(encoderSpeed[i] + encoderSpeedChange[encAcceleration], 0, encoderMaxAccSpeed[encAcceleration]);
-                else
-                    encoderSpeed[i] = 0;
+                if (position == position_t::stopped)
+                    continue;
+
+                if (!stepReadings[encoderID])
+                    movedEncoders[moved++] = encoderID;
+
+                BIT_SET(stepReadings[encoderID], reading);
+                BIT_WRITE(stepDirections[encoderID], reading, position == position_t::cw);
             }
 
-            lastDirection[i]    = encoderState;
-            lastMovementTime[i] = core::timing::currentRunTimeMs();
+            lastState[group] = state;
+        }
+    }
 
-            if (debounceDirection[i] != position_t::stopped)
-                encoderState = debounceDirection[i];
+    return moved;
+}
 
-            uint8_t  midiID       = database.read(Database::Section::encoder_t::midiID, i);
-            uint8_t  channel      = database.read(Database::Section::encoder_t::midiChannel, i);
-            auto     type         = static_cast<type_t>(database.read(Database::Section::encoder_t::mode, i));
-            bool     validType    = true;
-            uint16_t encoderValue = 0;
-            uint8_t  steps        = (encoderSpeed[i] > 0) ? encoderSpeed[i] : 1;
-            bool     use14bit     = false;
+///
+/// \brief Registers the transition of A/B signals of specified encoder.
+/// @param [in] encoderID       Encoder which is being checked.
+/// @param [in] previousState   Previous A/B signals of the encoder.
+/// @param [in] state           Current A/B signals of the encoder.
+/// \returns Encoder direction once enough pulses are registered for single step. See position_t.
+///
+Encoders::position_t Encoders::pulse(uint8_t encoderID, uint8_t previousState, uint8_t state)
+{
+    encoderPulses[encoderID] += encoderLookUpTable[(previousState << 2) | state];
 
-            MIDI::encDec_14bit_t encDec_14bit;
+    if (abs(encoderPulses[encoderID]) < pulsesPerStep[encoderID])
+        return position_t::stopped;
 
-            switch (type)
-            {
-            case type_t::t7Fh01h:
-            case type_t::t3Fh41h:
-                encoderValue = encValue[static_cast<uint8_t>(type)][static_cast<uint8_t>(encoderState)];
-                break;
+    auto position = (encoderPulses[encoderID] > 0) ? position_t::ccw : position_t::cw;
 
-            case type_t::tProgramChange:
-                if (encoderState == position_t::ccw)
-                {
-                    if (!Common::pcIncrement(channel))
-                        validType = false;
-                }
-                else
-                {
-                    if (!Common::pcDecrement(channel))
-                        validType = false;
-                }
+    //reset count
+    encoderPulses[encoderID] = 0;
 
-                encoderValue = Common::program(channel);
-                break;
+    return position;
+}
 
-            case type_t::tControlChange:
-            case type_t::tPitchBend:
-            case type_t::tNRPN7bit:
-            case type_t::tNRPN14bit:
-            case type_t::tControlChange14bit:
-                if ((type == type_t::tPitchBend) || (type == type_t::tNRPN14bit) || (type == type_t::tControlChange14bit))
-                    use14bit = true;
+///
+/// \brief Sends the steps specified encoder has made in all decoded readings.
+/// @param [in] encoderID           Encoder which has moved.
+/// @param [in] numberOfReadings    Amount of decoded readings.
+///
+void Encoders::process(uint8_t encoderID, uint8_t numberOfReadings)
+{
+    uint8_t readings   = stepReadings[encoderID];
+    uint8_t directions = stepDirections[encoderID];
 
-                if (use14bit && (steps > 1))
-                    steps <<= 2;
+    stepReadings[encoderID] = 0;
 
-                if (encoderState == position_t::ccw)
-                {
-                    midiValue[i] -= steps;
+    if (!database.read(Database::Section::encoder_t::enable, encoderID))
+        return;
 
-                    if (midiValue[i] < 0)
-                        midiValue[i] = 0;
-                }
-                else
-                {
-                    int16_t limit = use14bit ? 16383 : 127;
+    //disable debounce mode if encoder isn't moving for more than
+    //ENCODERS_DEBOUNCE_RESET_TIME milliseconds
+    if ((core::timing::currentRunTimeMs() - lastMovementTime[encoderID]) > ENCODERS_DEBOUNCE_RESET_TIME)
+    {
+        debounceCounter[encoderID]   = 0;
+        debounceDirection[encoderID] = position_t::stopped;
+    }
 
-                    midiValue[i] += steps;
+    auto acceleration = static_cast<acceleration_t>(database.read(Database::Section::encoder_t::acceleration, encoderID));
 
-                    if (midiValue[i] > limit)
-                        midiValue[i] = limit;
-                }
+    //net amount of detents and net amount of steps once acceleration is applied, positive in cw direction
+    int16_t steps            = 0;
+    int16_t acceleratedSteps = 0;
 
-                encoderValue = midiValue[i];
-                break;
+    for (uint8_t reading = 0; reading < numberOfReadings; reading++)
+    {
+        if (!BIT_READ(readings, reading))
+            continue;
 
-            case type_t::tPresetChange:
-                //nothing to do - valid type
-                break;
+        auto encoderState = filterDirection(encoderID, BIT_READ(directions, reading) ? position_t::cw : position_t::ccw);
 
-            default:
-                validType = false;
-                break;
-            }
+        //each detent is accelerated based on the time at which it was read,
+        //so that the result doesn't depend on how often this function is called
+        uint8_t detentStepCount = detentSteps(encoderID, acceleration, hwa.readingTime(reading));
+
+        if (encoderState == position_t::cw)
+        {
+            steps++;
+            acceleratedSteps += detentStepCount;
+        }
+        else
+        {
+            steps--;
+            acceleratedSteps -= detentStepCount;
+        }
+    }
+
+    if (!steps)
+        return;
+
+    lastMovementTime[encoderID] = core::timing::currentRunTimeMs();
+    localSequence[encoderID]++;
+
+    sendMessage(encoderID, steps, acceleratedSteps);
+    cInfo.send(Database::block_t::encoders, encoderID);
+}
+
+///
+/// \brief Applies invert setting and debouncing to single movement of specified encoder.
+/// @param [in] encoderID       Encoder which has moved.
+/// @param [in] encoderState    Direction of the movement. Must not be position_t::stopped.
+/// \returns Direction which should be used for the movement.
+///
+Encoders::position_t Encoders::filterDirection(uint8_t encoderID, position_t encoderState)
+{
+    if (database.read(Database::Section::encoder_t::invert, encoderID))
+    {
+        if (encoderState == position_t::ccw)
+            encoderState = position_t::cw;
+        else
+            encoderState = position_t::ccw;
+    }
+
+    if (debounceCounter[encoderID] != ENCODERS_DEBOUNCE_COUNT)
+    {
+        if (encoderState != lastDirection[encoderID])
+            debounceCounter[encoderID] = 0;
+
+        debounceCounter[encoderID]++;
+
+        if (debounceCounter[encoderID] == ENCODERS_DEBOUNCE_COUNT)
+        {
+            debounceCounter[encoderID]   = 0;
+            debounceDirection[encoderID] = encoderState;
+        }
+    }
+
+    lastDirection[encoderID] = encoderState;
+
+    if (debounceDirection[encoderID] != position_t::stopped)
+        encoderState = debounceDirection[encoderID];
+
+    return encoderState;
+}
+
+///
+/// \brief Updates speed estimate of specified encoder and calculates amount of steps single detent produces.
+/// Speed is estimated as exponentially averaged time between detents which is then mapped
+/// to amount of steps through the quadratic curve defined by acceleration profile.
+/// @param [in] encoderID       Encoder which has moved.
+/// @param [in] acceleration    Acceleration setting of the encoder.
+/// @param [in] time            Time in microseconds at which the detent has been read.
+/// \returns Amount of steps the detent produces.
+///
+uint8_t Encoders::detentSteps(uint8_t encoderID, acceleration_t acceleration, uint32_t time)
+{
+    uint32_t interval = time - lastDetentTime[encoderID];
+
+    lastDetentTime[encoderID] = time;
+
+    if ((interval > ENCODERS_SPEED_TIMEOUT) || !detentInterval[encoderID])
+    {
+        //encoder has just started moving
+        detentInterval[encoderID] = ENCODERS_SPEED_TIMEOUT;
+    }
+    else if (interval > detentInterval[encoderID])
+    {
+        detentInterval[encoderID] += (interval - detentInterval[encoderID]) >> ENCODERS_SPEED_SMOOTHING;
+    }
+    else
+    {
+        detentInterval[encoderID] -= (detentInterval[encoderID] - interval) >> ENCODERS_SPEED_SMOOTHING;
+    }
+
+    if (acceleration >= acceleration_t::AMOUNT)
+        return 1;
+
+    auto& profile = accelerationProfile[static_cast<uint8_t>(acceleration)];
+
+    if (detentInterval[encoderID] >= profile.slowInterval)
+        return 1;
+
+    if (detentInterval[encoderID] <= profile.fastInterval)
+        return profile.maxSteps;
+
+    //position between slow and fast interval with 8 fractional bits
+    uint32_t position = ((profile.slowInterval - detentInterval[encoderID]) << 8) / (profile.slowInterval - profile.fastInterval);
+
+    return 1 + (((profile.maxSteps - 1) * position * position) >> 16);
+}
+
+///
+/// \brief Sends single message for all steps the encoder has made since the last check.
+/// @param [in] encoderID           Encoder which has moved.
+/// @param [in] steps               Net amount of detents. Positive in cw direction, negative in ccw direction.
+/// @param [in] acceleratedSteps    Net amount of steps once acceleration is applied to each detent.
+///
+void Encoders::sendMessage(uint8_t encoderID, int16_t steps, int16_t acceleratedSteps)
+{
+    uint8_t  midiID       = database.read(Database::Section::encoder_t::midiID, encoderID);
+    uint8_t  channel      = database.read(Database::Section::encoder_t::midiChannel, encoderID);
+    auto     type         = static_cast<type_t>(database.read(Database::Section::encoder_t::mode, encoderID));
+    bool     validType    = true;
+    uint16_t encoderValue = 0;
+    bool     use14bit     = false;
+
+    MIDI::encDec_14bit_t encDec_14bit;
+
+    switch (type)
+    {
+    case type_t::t7Fh01h:
+    case type_t::t3Fh41h:
+    case type_t::t41h01h:
+    {
+        //all steps made since the last message are sent at once, including acceleration
+        int16_t delta = CONSTRAIN(acceleratedSteps, -ENCODERS_RELATIVE_MAX_STEPS, ENCODERS_RELATIVE_MAX_STEPS);
+
+        if (type == type_t::t7Fh01h)
+        {
+            //two's complement
+            encoderValue = delta & 0x7F;
+        }
+        else if (type == type_t::t3Fh41h)
+        {
+            //offset binary with 64 as center
+            encoderValue = 64 + delta;
+        }
+        else
+        {
+            //signed bit: bit 6 is set for negative values, magnitude is in lower bits
+            encoderValue = (delta < 0) ? (0x40 | -delta) : delta;
+        }
+    }
+    break;
+
+    case type_t::t1FFFh2001h:
+    {
+        //acceleration is 4 times larger in 14-bit modes due to a larger value range
+        int32_t delta = steps + (static_cast<int32_t>(acceleratedSteps) - steps) * 4;
+
+        //offset binary with 8192 as center, sent as 14-bit control change
+        encoderValue = 8192 + CONSTRAIN(delta, -ENCODERS_RELATIVE_MAX_STEPS_14BIT, ENCODERS_RELATIVE_MAX_STEPS_14BIT);
+    }
+    break;
+
+    case type_t::tProgramChange:
+    {
+        validType = false;
+
+        for (int16_t i = 0; i < abs(steps); i++)
+        {
+            if ((steps < 0) ? Common::pcIncrement(channel) : Common::pcDecrement(channel))
+                validType = true;
+        }
+
+        encoderValue = Common::program(channel);
+    }
+    break;
+
+    case type_t::tControlChange:
+    case type_t::tPitchBend:
+    case type_t::tNRPN7bit:
+    case type_t::tNRPN14bit:
+    case type_t::tControlChange14bit:
+    {
+        if ((type == type_t::tPitchBend) || (type == type_t::tNRPN14bit) || (type == type_t::tControlChange14bit))
+            use14bit = true;
+
+        //acceleration is 4 times larger in 14-bit modes due to a larger value range
+        int32_t delta = acceleratedSteps;
+
+        if (use14bit)
+            delta = steps + (static_cast<int32_t>(acceleratedSteps) - steps) * 4;
+
+        int32_t value = midiValue[encoderID] + delta;
+        int32_t limit = use14bit ? 16383 : 127;
+
+        midiValue[encoderID] = CONSTRAIN(value, 0, limit);
+        encoderValue         = midiValue[encoderID];
+    }
+    break;
+
+    case type_t::tPresetChange:
+        //nothing to do - valid type
+        break;
 
-            if (validType)
+    default:
+        validType = false;
+        break;
+    }
+
+    if (!validType)
+        return;
+
+    if (type == type_t::tProgramChange)
+    {
+        midi.sendProgramChange(encoderValue, channel);
+        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::programChange, midiID & 0x7F, encoderValue, channel + 1);
+    }
+    else if (type == type_t::tPitchBend)
+    {
+        midi.sendPitchBend(encoderValue, channel);
+        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::pitchBend, midiID & 0x7F, encoderValue, channel + 1);
+    }
+    else if ((type == type_t::tNRPN7bit) || (type == type_t::tNRPN14bit) || (type == type_t::tControlChange14bit))
+    {
+        encDec_14bit.value = midiID;
+        encDec_14bit.split14bit();
+
+        midi.sendControlChange(99, encDec_14bit.high, channel);
+        midi.sendControlChange(98, encDec_14bit.low, channel);
+
+        if (type == type_t::tNRPN7bit)
+        {
+            midi.sendControlChange(6, encoderValue, channel);
+        }
+        else
+        {
+            midiID = encDec_14bit.low;
+
+            encDec_14bit.value = encoderValue;
+            encDec_14bit.split14bit();
+
+            if (type == type_t::tControlChange14bit)
             {
-                if (type == type_t::tProgramChange)
-                {
-                    midi.sendProgramChange(encoderValue, channel);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::programChange, midiID & 0x7F, encoderValue, channel + 1);
-                }
-                else if (type == type_t::tPitchBend)
-                {
-                    midi.sendPitchBend(encoderValue, channel);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::pitchBend, midiID & 0x7F, encoderValue, channel + 1);
-                }
-                else if ((type == type_t::tNRPN7bit) || (type == type_t::tNRPN14bit) || (type == type_t::tControlChange14bit))
-                {
-                    encDec_14bit.value = midiID;
-                    encDec_14bit.split14bit();
-
-                    midi.sendControlChange(99, encDec_14bit.high, channel);
-                    midi.sendControlChange(98, encDec_14bit.low, channel);
-
-                    if (type == type_t::tNRPN7bit)
-                    {
-                        midi.sendControlChange(6, encoderValue, channel);
-                    }
-                    else
-                    {
-                        midiID = encDec_14bit.low;
-
-                        encDec_14bit.value = encoderValue;
-                        encDec_14bit.split14bit();
-
-                        if (type == type_t::tControlChange14bit)
-                        {
-                            if (midiID >= 96)
-                                break;    //not allowed
-
-                            midi.sendControlChange(midiID, encDec_14bit.high, channel);
-                            midi.sendControlChange(midiID + 32, encDec_14bit.low, channel);
-                        }
-                        else
-                        {
-                            midi.sendControlChange(6, encDec_14bit.high, channel);
-                            midi.sendControlChange(38, encDec_14bit.low, channel);
-                        }
-                    }
-
-                    display.displayMIDIevent(Display::eventType_t::out, (type == type_t::tControlChange14bit) ? Display::event_t::controlChange : Display::event_t::nrpn, midiID, encoderValue, channel + 1);
-                }
-                else if (type != type_t::tPresetChange)
-                {
-                    midi.sendControlChange(midiID, encoderValue, channel);
-                    display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, midiID & 0x7F, encoderValue, channel + 1);
-                }
-                else
-                {
-                    uint8_t preset = database.getPreset();
-                    preset += (encoderState == position_t::cw) ? 1 : -1;
+                if (midiID >= 96)
+                    return;    //not allowed
 
-                    database.setPreset(preset);
-                }
+                midi.sendControlChange(midiID, encDec_14bit.high, channel);
+                midi.sendControlChange(midiID + 32, encDec_14bit.low, channel);
+            }
+            else
+            {
+                midi.sendControlChange(6, encDec_14bit.high, channel);
+                midi.sendControlChange(38, encDec_14bit.low, channel);
             }
-
-            cInfo.send(Database::block_t::encoders, i);
         }
+
+        display.displayMIDIevent(Display::eventType_t::out, (type == type_t::tControlChange14bit) ? Display::event_t::controlChange : Display::event_t::nrpn, midiID, encoderValue, channel + 1);
+    }
+    else if (type == type_t::t1FFFh2001h)
+    {
+        if (midiID >= 96)
+            return;    //not allowed
+
+        encDec_14bit.value = encoderValue;
+        encDec_14bit.split14bit();
+
+        midi.sendControlChange(midiID, encDec_14bit.high, channel);
+        midi.sendControlChange(midiID + 32, encDec_14bit.low, channel);
+        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, midiID, encoderValue, channel + 1);
+    }
+    else if (type != type_t::tPresetChange)
+    {
+        midi.sendControlChange(midiID, encoderValue, channel);
+        display.displayMIDIevent(Display::eventType_t::out, Display::event_t::controlChange, midiID & 0x7F, encoderValue, channel + 1);
+    }
+    else
+    {
+        uint8_t preset = database.getPreset();
+        preset += steps;
+
+        database.setPreset(preset);
     }
 }
 
@@ -244,16 +472,66 @@ void Encoders::resetValue(uint8_t encoderID)
         midiValue[encoderID] = 0;
 
     lastMovementTime[encoderID]  = 0;
-    encoderSpeed[encoderID]      = 0;
+    lastDetentTime[encoderID]    = 0;
+    detentInterval[encoderID]    = 0;
     debounceDirection[encoderID] = position_t::stopped;
     debounceCounter[encoderID]   = 0;
-    encoderData[encoderID]       = 0;
     encoderPulses[encoderID]     = 0;
+    pulsesPerStep[encoderID]     = database.read(Database::Section::encoder_t::pulsesPerStep, encoderID);
+
+    //discard remote sync value which could be pending
+    localSequence[encoderID]++;
+
+    //next reading is used as reference only
+    BIT_SET(referenceMissing[encoderID / ENCODERS_PER_GROUP], encoderID % ENCODERS_PER_GROUP);
 }
 
+///
+/// \brief Stores value received from remote side for specified encoder.
+/// Value isn't applied immediately: only the last value received before the next
+/// update is kept and applied once all local movements have been processed.
+/// @param [in] encoderID   Index of encoder for which value is received.
+/// @param [in] value       New MIDI value.
+///
 void Encoders::setValue(uint8_t encoderID, uint16_t value)
 {
-    midiValue[encoderID] = value;
+    if (encoderID >= MAX_NUMBER_OF_ENCODERS)
+        return;
+
+    if (!pendingSync[encoderID])
+    {
+        pendingSync[encoderID]                = true;
+        syncedEncoders[syncedEncodersCount++] = encoderID;
+    }
+
+    pendingSyncValue[encoderID]    = value;
+    pendingSyncSequence[encoderID] = localSequence[encoderID];
+}
+
+///
+/// \brief Applies pending remote sync values.
+/// Value is discarded if the encoder has been moved locally or reset after the value has been received,
+/// or if it has been moved less than ENCODERS_REMOTE_SYNC_GRACE_TIME milliseconds ago,
+/// since in that case the value is most likely an echo of an already outdated value.
+///
+void Encoders::applyRemoteSync()
+{
+    for (size_t i = 0; i < syncedEncodersCount; i++)
+    {
+        uint8_t encoderID = syncedEncoders[i];
+
+        pendingSync[encoderID] = false;
+
+        if (pendingSyncSequence[encoderID] != localSequence[encoderID])
+            continue;
+
+        if (lastMovementTime[encoderID] && ((core::timing::currentRunTimeMs() - lastMovementTime[encoderID]) < ENCODERS_REMOTE_SYNC_GRACE_TIME))
+            continue;
+
+        midiValue[encoderID] = pendingSyncValue[encoderID];
+    }
+
+    syncedEncodersCount = 0;
 }
 
 ///
@@ -264,32 +542,22 @@ void Encoders::setValue(uint8_t encoderID, uint16_t value)
 ///
 Encoders::position_t Encoders::read(uint8_t encoderID, uint8_t pairState)
 {
-    position_t returnValue = position_t::stopped;
-    pairState &= 0x03;
+    uint8_t group         = encoderID / ENCODERS_PER_GROUP;
+    uint8_t slot          = encoderID % ENCODERS_PER_GROUP;
+    uint8_t shift         = slot * 2;
+    uint8_t previousState = (lastState[group] >> shift) & 0x03;
 
-    //add new data
+    pairState &= 0x03;
 
-    bool process = true;
+    lastState[group] &= ~(0x03 << shift);
+    lastState[group] |= pairState << shift;
 
     //only process the data from encoder if there is a previous reading stored
-    if (!BIT_READ(encoderData[encoderID], 7))
-        process = false;
-
-    encoderData[encoderID] <<= 2;
-    encoderData[encoderID] |= pairState;
-    encoderData[encoderID] |= 0x80;
-
-    if (!process)
-        return returnValue;
-
-    encoderPulses[encoderID] += encoderLookUpTable[encoderData[encoderID] & 0x0F];
-
-    if (abs(encoderPulses[encoderID]) >= database.read(Database::Section::encoder_t::pulsesPerStep, encoderID))
+    if (BIT_READ(referenceMissing[group], slot))
     {
-        returnValue = (encoderPulses[encoderID] > 0) ? position_t::ccw : position_t::cw;
-        //reset count
-        encoderPulses[encoderID] = 0;
+        BIT_CLEAR(referenceMissing[group], slot);
+        return position_t::stopped;
     }
 
-    return returnValue;
-}
\ No newline at end of file
+    return pulse(encoderID, previousState, pairState);
+}
@@ -50,6 +50,8 @@ namespace IO
             tNRPN7bit,
             tNRPN14bit,
             tControlChange14bit,
+            t41h01h,
+            t1FFFh2001h,
             AMOUNT
         };
 
@@ -69,10 +71,43 @@ namespace IO
             AMOUNT
         };
 
+        ///
+        /// \brief Amount of encoders whose A/B signals are packed in single byte.
+        ///
+        static constexpr size_t ENCODERS_PER_GROUP = 4;
+
+        ///
+        /// \brief Amount of groups of ENCODERS_PER_GROUP encoders.
+        ///
+        static constexpr size_t NUMBER_OF_GROUPS = (MAX_NUMBER_OF_ENCODERS + ENCODERS_PER_GROUP - 1) / ENCODERS_PER_GROUP;
+
+        ///
+        /// \brief Maximum amount of readings processed in single update.
+        ///
+        static constexpr uint8_t MAX_READINGS = 8;
+
         class HWA
         {
             public:
-            virtual uint8_t state(size_t index) = 0;
+            ///
+            /// \brief Returns amount of readings available since the last call.
+            ///
+            virtual uint8_t readings() = 0;
+
+            ///
+            /// \brief Returns A/B signals of single group of encoders from specified reading.
+            /// @param [in] reading Index of reading, 0 being the oldest one.
+            /// @param [in] group   Index of group. Group n holds encoders n*ENCODERS_PER_GROUP
+            ///                     to (n+1)*ENCODERS_PER_GROUP-1.
+            /// \returns A and B signals of k-th encoder in group stored in bits 2k+1 and 2k.
+            ///
+            virtual uint8_t state(uint8_t reading, uint8_t group) = 0;
+
+            ///
+            /// \brief Returns time in microseconds at which specified reading has been taken.
+            /// @param [in] reading Index of reading, 0 being the oldest one.
+            ///
+            virtual uint32_t readingTime(uint8_t reading) = 0;
         };
 
         Encoders(HWA& hwa, Database& database, MIDI& midi, Display& display, ComponentInfo& cInfo)
@@ -90,6 +125,26 @@ namespace IO
         position_t read(uint8_t encoderID, uint8_t pairState);
 
         private:
+        ///
+        /// \brief Parameters of single acceleration setting.
+        /// Amount of steps single detent produces rises from 1 to maxSteps following quadratic curve
+        /// while average time between detents falls from slowInterval to fastInterval.
+        ///
+        struct accelerationProfile_t
+        {
+            uint32_t slowInterval;    ///< Average time between detents in microseconds above which encoder isn't accelerated.
+            uint32_t fastInterval;    ///< Average time between detents in microseconds at which maximum acceleration is reached.
+            uint8_t  maxSteps;        ///< Amount of steps single detent produces at maximum acceleration.
+        };
+
+        size_t     decode(uint8_t numberOfReadings);
+        position_t pulse(uint8_t encoderID, uint8_t previousState, uint8_t state);
+        void       process(uint8_t encoderID, uint8_t numberOfReadings);
+        position_t filterDirection(uint8_t encoderID, position_t encoderState);
+        uint8_t    detentSteps(uint8_t encoderID, acceleration_t acceleration, uint32_t time);
+        void       sendMessage(uint8_t encoderID, int16_t steps, int16_t acceleratedSteps);
+        void       applyRemoteSync();
+
         HWA&           hwa;
         Database&      database;
         MIDI&          midi;
@@ -107,9 +162,45 @@ namespace IO
         uint32_t lastMovementTime[MAX_NUMBER_OF_ENCODERS] = {};
 
         ///
-        /// \brief Array holding current speed (in steps) for all encoders.
+        /// \brief Incremented each time local movement of an encoder changes its value.
+        ///
+        uint8_t localSequence[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Remote sync value received for each encoder which hasn't been applied yet.
+        /// Only the last value received between two updates is kept.
+        ///
+        uint16_t pendingSyncValue[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Value of localSequence at the time pending remote sync value has been received.
+        ///
+        uint8_t pendingSyncSequence[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Flags indicating whether remote sync value is pending for each encoder.
+        ///
+        bool pendingSync[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief List of encoders with pending remote sync value.
+        ///
+        uint8_t syncedEncoders[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Amount of encoders stored in syncedEncoders.
         ///
-        uint8_t encoderSpeed[MAX_NUMBER_OF_ENCODERS] = {};
+        size_t syncedEncodersCount = 0;
+
+        ///
+        /// \brief Array holding time in microseconds of last detent for all encoders.
+        ///
+        uint32_t lastDetentTime[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Array holding exponentially averaged time between detents in microseconds for all encoders.
+        ///
+        uint32_t detentInterval[MAX_NUMBER_OF_ENCODERS] = {};
 
         ///
         /// \brief Array holding previous encoder direction for all encoders.
@@ -132,9 +223,34 @@ namespace IO
         uint8_t debounceCounter[MAX_NUMBER_OF_ENCODERS] = {};
 
         ///
-        /// \brief Array holding last two readings from encoder pins.
+        /// \brief Last A/B signals of all encoders, packed in the same way as returned by HWA.
+        ///
+        uint8_t lastState[NUMBER_OF_GROUPS] = {};
+
+        ///
+        /// \brief Bitmask of encoders in each group for which the next reading is used as reference only.
+        ///
+        uint8_t referenceMissing[NUMBER_OF_GROUPS] = {};
+
+        ///
+        /// \brief Cached amount of pulses per step for all encoders.
+        ///
+        uint8_t pulsesPerStep[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Bitmask of readings in which each encoder made a step during current update.
+        ///
+        uint8_t stepReadings[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief Bitmask of readings in which the step was made in cw direction.
+        ///
+        uint8_t stepDirections[MAX_NUMBER_OF_ENCODERS] = {};
+
+        ///
+        /// \brief List of encoders which made at least one step during current update.
         ///
-        uint8_t encoderData[MAX_NUMBER_OF_ENCODERS] = {};
+        uint8_t movedEncoders[MAX_NUMBER_OF_ENCODERS] = {};
 
         ///
         /// \brief Array holding current amount of pulses for all encoders.
@@ -164,46 +280,36 @@ namespace IO
         };
 
         ///
-        /// \brief Used to achieve linear encoder acceleration on fast movement.
-        /// Every time fast movement is detected, amount of steps is increased by this value.
-        /// Used only in CC/Pitch bend/NRPN modes. In Pitch bend/NRPN modes, this value is multiplied
-        /// by 4 due to a larger value range.
+        /// \brief Acceleration parameters for each acceleration setting.
         ///
-        const uint8_t encoderSpeedChange[static_cast<uint8_t>(IO::Encoders::acceleration_t::AMOUNT)] = {
-            0,    //acceleration disabled
-            1,
-            2,
-            3
-        };
+        const accelerationProfile_t accelerationProfile[static_cast<uint8_t>(IO::Encoders::acceleration_t::AMOUNT)] = {
+            //acceleration disabled
+            {
+                .slowInterval = 0,
+                .fastInterval = 0,
+                .maxSteps     = 1,
+            },
 
-        ///
-        /// \brief Maximum value by which MIDI value is increased during acceleration.
-        ///
-        const uint8_t encoderMaxAccSpeed[static_cast<uint8_t>(IO::Encoders::acceleration_t::AMOUNT)] = {
-            0,    //acceleration disabled
-            5,
-            10,
-            100
-        };
+            //slow
+            {
+                .slowInterval = 60000,
+                .fastInterval = 15000,
+                .maxSteps     = 5,
+            },
 
-        ///
-        /// \brief Array used for easier access to current encoder MIDI value in 7Fh01h and 3Fh41h modes.
-        /// Matched with type_t and position_t
-        ///
-        const uint8_t encValue[2][3] = {
-            //t7Fh01h
+            //medium
             {
-                0,      //stopped
-                127,    //ccw
-                1       //cw
+                .slowInterval = 60000,
+                .fastInterval = 10000,
+                .maxSteps     = 10,
             },
 
-            //t3Fh41h
+            //fast
             {
-                0,     //stopped
-                63,    //ccw
-                65     //cw
-            }
+                .slowInterval = 60000,
+                .fastInterval = 5000,
+                .maxSteps     = 100,
+            },
         };
     };
 
@@ -41,6 +41,8 @@ namespace IO
             tNRPN7bit,
             tNRPN14bit,
             tControlChange14bit,
+            t41h01h,
+            t1FFFh2001h,
             AMOUNT
         };
 
@@ -63,7 +65,9 @@ namespace IO
         class HWA
         {
             public:
-            virtual uint8_t state(size_t index) = 0;
+            virtual uint8_t  readings()                             = 0;
+            virtual uint8_t  state(uint8_t reading, uint8_t group) = 0;
+            virtual uint32_t readingTime(uint8_t reading)          = 0;
         };
 
         Encoders(HWA& hwa, Database& database, MIDI& midi, Display& display, ComponentInfo& cInfo)
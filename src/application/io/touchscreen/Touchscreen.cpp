@@ -22,7 +22,7 @@ using namespace IO;
 
 #define MODEL modelPtr[activeModel]
 
-core::RingBuffer<uint8_t, IO::Touchscreen::Model::Common::bufferSize> IO::Touchscreen::Model::Common::rxBuffer;
+SPSCRingBuffer<uint8_t, IO::Touchscreen::Model::Common::bufferSize> IO::Touchscreen::Model::Common::rxBuffer;
 
 bool Touchscreen::init()
 {
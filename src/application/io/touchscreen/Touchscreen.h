@@ -21,7 +21,7 @@ limitations under the License.
 #include <inttypes.h>
 #include <stdlib.h>
 #include "database/Database.h"
-#include "core/src/general/RingBuffer.h"
+#include "common/SPSCRingBuffer/SPSCRingBuffer.h"
 
 #ifndef TOUCHSCREEN_SUPPORTED
 #include "Stub.h"
@@ -72,8 +72,8 @@ namespace IO
                 Common() {}
 
                 protected:
-                static const size_t                          bufferSize = 100;
-                static core::RingBuffer<uint8_t, bufferSize> rxBuffer;
+                static const size_t                        bufferSize = 128;
+                static SPSCRingBuffer<uint8_t, bufferSize> rxBuffer;
             };
 
             enum class model_t : uint8_t
@@ -79,15 +79,16 @@ bool Nextion::update(size_t& buttonID, bool& state)
             {
                 if (IO::Touchscreen::Model::Common::rxBuffer.count() >= 5)
                 {
+                    uint8_t event[2];
+
+                    IO::Touchscreen::Model::Common::rxBuffer.read(event, 2);
+
                     //state
                     //1 - pressed, 0 - released
-                    IO::Touchscreen::Model::Common::rxBuffer.remove(data);
-
-                    state = data ? 1 : 0;
+                    state = event[0] ? 1 : 0;
 
                     //button id
-                    IO::Touchscreen::Model::Common::rxBuffer.remove(data);
-                    buttonID = data;
+                    buttonID = event[1];
 
                     IO::Touchscreen::Model::Common::rxBuffer.reset();
                     return true;
@@ -87,8 +87,7 @@ bool Viewtech::update(size_t& buttonID, bool& state)
         {
             uint8_t startHeader[2];
 
-            IO::Touchscreen::Model::Common::rxBuffer.remove(startHeader[0]);
-            IO::Touchscreen::Model::Common::rxBuffer.remove(startHeader[1]);
+            IO::Touchscreen::Model::Common::rxBuffer.read(startHeader, 2);
 
             if ((startHeader[0] == 0xA5) && (startHeader[1] == 0x5A))
             {
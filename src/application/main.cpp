@@ -155,7 +155,9 @@ class HWAMIDI : public MIDI::HWA
     {
 #ifndef USB_MIDI_SUPPORTED
         //enable uart-to-usb link when usb isn't supported directly
-        Board::UART::init(UART_CHANNEL_USB_LINK, UART_BAUDRATE_MIDI_OD);
+        //once the link is up, switch to the fastest baud rate usb link supports
+        if (Board::UART::init(UART_CHANNEL_USB_LINK, UART_BAUDRATE_MIDI_OD))
+            OpenDeckMIDIformat::negotiateBaudRate(UART_CHANNEL_USB_LINK);
 #endif
 
         //unlike usb midi, din midi is configurable by user
@@ -185,7 +187,18 @@ class HWAMIDI : public MIDI::HWA
     bool usbRead(MIDI::USBMIDIpacket_t& USBMIDIpacket) override
     {
 #ifdef USB_MIDI_SUPPORTED
-        return Board::USB::readMIDI(USBMIDIpacket);
+        //fetch packets from usb in batches and hand them out one by one
+        if (usbPacketIndex == usbPacketCount)
+        {
+            usbPacketIndex = 0;
+            usbPacketCount = Board::USB::readMIDI(usbPackets, USB_READ_PACKETS);
+
+            if (!usbPacketCount)
+                return false;
+        }
+
+        USBMIDIpacket = usbPackets[usbPacketIndex++];
+        return true;
 #else
         OpenDeckMIDIformat::packetType_t odPacketType;
 
@@ -204,9 +217,35 @@ class HWAMIDI : public MIDI::HWA
 #ifdef USB_MIDI_SUPPORTED
         return Board::USB::writeMIDI(USBMIDIpacket);
 #else
-        return OpenDeckMIDIformat::write(UART_CHANNEL_USB_LINK, USBMIDIpacket, OpenDeckMIDIformat::packetType_t::midi);
+        return OpenDeckMIDIformat::writeMIDI(UART_CHANNEL_USB_LINK, USBMIDIpacket);
+#endif
+    }
+
+    ///
+    /// \brief Sends all MIDI packets queued for USB link.
+    /// Should be called once per main loop iteration.
+    ///
+    void flush()
+    {
+#ifndef USB_MIDI_SUPPORTED
+        OpenDeckMIDIformat::flush(UART_CHANNEL_USB_LINK);
 #endif
     }
+
+#ifdef USB_MIDI_SUPPORTED
+    private:
+    ///
+    /// \brief Maximum amount of packets read from USB interface at once.
+    ///
+    static constexpr size_t USB_READ_PACKETS = 16;
+
+    ///
+    /// \brief Packets read from USB interface which haven't been processed yet.
+    ///
+    MIDI::USBMIDIpacket_t usbPackets[USB_READ_PACKETS];
+    size_t                usbPacketCount = 0;
+    size_t                usbPacketIndex = 0;
+#endif
 } hwaMIDI;
 
 #ifdef LEDS_SUPPORTED
@@ -344,9 +383,19 @@ class HWAEncoders : public IO::Encoders::HWA
     public:
     HWAEncoders() = default;
 
-    uint8_t state(size_t index) override
+    uint8_t readings() override
+    {
+        return Board::io::getNumberOfInputReadings();
+    }
+
+    uint8_t state(uint8_t reading, uint8_t group) override
+    {
+        return Board::io::getEncoderStates(reading, group);
+    }
+
+    uint32_t readingTime(uint8_t reading) override
     {
-        return Board::io::getEncoderPairState(index);
+        return Board::io::getInputReadingTime(reading);
     }
 } hwaEncoders;
 
@@ -364,6 +413,17 @@ class HWAButtons : public IO::Buttons::HWA
 
         return Board::io::getButtonState(index);
     }
+
+    uint32_t stateTime() override
+    {
+        //button states are taken from the most recent reading
+        return Board::io::getInputReadingTime(Board::io::getNumberOfInputReadings() - 1);
+    }
+
+    uint32_t currentTime() override
+    {
+        return Board::io::getInputScanTime();
+    }
 } hwaButtons;
 
 #include "io/buttons/Filter.h"
@@ -375,7 +435,17 @@ class HWAEncodersStub : public IO::Encoders::HWA
     public:
     HWAEncodersStub() {}
 
-    uint8_t state(size_t index) override
+    uint8_t readings() override
+    {
+        return 0;
+    }
+
+    uint8_t state(uint8_t reading, uint8_t group) override
+    {
+        return 0;
+    }
+
+    uint32_t readingTime(uint8_t reading) override
     {
         return 0;
     }
@@ -390,6 +460,16 @@ class HWAButtonsStub : public IO::Buttons::HWA
     {
         return false;
     }
+
+    uint32_t stateTime() override
+    {
+        return 0;
+    }
+
+    uint32_t currentTime() override
+    {
+        return 0;
+    }
 } hwaButtons;
 
 class ButtonsFilterStub : public IO::Buttons::Filter
@@ -397,7 +477,7 @@ class ButtonsFilterStub : public IO::Buttons::Filter
     public:
     ButtonsFilterStub() {}
 
-    bool isFiltered(size_t index, bool state, bool& filteredState) override
+    bool isFiltered(size_t index, bool state, uint32_t time, uint32_t debounceTime, IO::Buttons::debounceMode_t debounceMode, bool& filteredState) override
     {
         return false;
     }
@@ -420,19 +500,41 @@ class HWAAnalog : public IO::Analog::HWA
     public:
     HWAAnalog() = default;
 
-    bool value(size_t index, uint16_t& value) override
+    void setScanState(size_t index, bool state) override
     {
-        return Board::io::analogValue(index, value);
+        Board::io::setAnalogScanState(index, state);
+    }
+
+    void setOversamplingState(size_t index, bool state) override
+    {
+        Board::io::setAnalogOversamplingState(index, state);
+    }
+
+    void setPeakDetectionState(size_t index, bool state) override
+    {
+        Board::io::setAnalogPeakDetectionState(index, state);
+    }
+
+    size_t newValues(uint8_t* indexes, uint16_t* values, size_t maxValues) override
+    {
+        return Board::io::analogNewValues(indexes, values, maxValues);
     }
 } hwaAnalog;
 
 #include "io/analog/Filter.h"
 
+//adaptive filtering is used only on targets which explicitly enable it
+#ifdef ANALOG_FILTER_ADAPTIVE
+#define ANALOG_FILTER_MODE IO::AnalogFilter::filterMode_t::adaptive
+#else
+#define ANALOG_FILTER_MODE IO::AnalogFilter::filterMode_t::timed
+#endif
+
 #ifdef __AVR__
-IO::AnalogFilter analogFilter(ADC_RESOLUTION, 1);
+IO::AnalogFilter analogFilter(ADC_RESOLUTION, 1, ANALOG_FILTER_MODE);
 #else
 //stm32 has more sensitive ADC, use more repetitions
-IO::AnalogFilter analogFilter(ADC_RESOLUTION, 3);
+IO::AnalogFilter analogFilter(ADC_RESOLUTION, 3, ANALOG_FILTER_MODE);
 #endif
 #else
 class HWAAnalogStub : public IO::Analog::HWA
@@ -558,6 +660,33 @@ class SystemHWA : public System::HWA
 #endif
     }
 
+    void setDINMIDIrunningStatusState(bool state) override
+    {
+#ifdef DIN_MIDI_SUPPORTED
+        Board::UART::setMIDIrunningStatusState(UART_CHANNEL_DIN, state);
+#endif
+    }
+
+    uint32_t dinMIDIbytesPerSecond() override
+    {
+#ifdef DIN_MIDI_SUPPORTED
+        return Board::UART::txBytesPerSecond(UART_CHANNEL_DIN);
+#else
+        return 0;
+#endif
+    }
+
+    bool usbLinkState(uint32_t& baudRate, uint32_t& errorCount) override
+    {
+#ifndef USB_MIDI_SUPPORTED
+        baudRate   = OpenDeckMIDIformat::baudRate();
+        errorCount = OpenDeckMIDIformat::errorCount();
+        return true;
+#else
+        return false;
+#endif
+    }
+
     private:
 #ifdef DIN_MIDI_SUPPORTED
     bool dinMIDIenabled         = false;
@@ -588,6 +717,9 @@ int main()
     };
 
     dbHandlers.presetChangeHandler = [](uint8_t preset) {
+        buttons.init();
+        encoders.init();
+        analog.init();
         leds.midiToState(MIDI::messageType_t::programChange, preset, 0, 0, true);
 
         if (display.init(false))
@@ -638,6 +770,7 @@ int main()
     while (true)
     {
         sys.run();
+        hwaMIDI.flush();
     }
 
     return 1;
@@ -34,13 +34,16 @@ limitations under the License.
 #define SYSEX_CR_SUPPORTED_PRESETS             0x50
 #define SYSEX_CR_BOOTLOADER_SUPPORT            0x51
 #define SYSEX_CR_FULL_BACKUP                   0x1B
+#define SYSEX_CR_DIN_BANDWIDTH                 0x62
+#define SYSEX_CR_USB_LINK_STATE                0x4C
+#define SYSEX_CR_ANALOG_CALIBRATION            0x63
 
 /// @}
 
 ///
 /// \brief Total number of custom requests.
 ///
-#define NUMBER_OF_CUSTOM_REQUESTS 12
+#define NUMBER_OF_CUSTOM_REQUESTS 15
 
 ///
 /// \brief Custom ID used when sending info about components to host.
@@ -21,7 +21,10 @@
 #include "sysex/src/SysExConf.h"
 #include "io/leds/LEDs.h"
 #include "io/encoders/Encoders.h"
+#include "io/buttons/Constants.h"
 #include "io/encoders/Constants.h"
+#include "io/analog/Constants.h"
+#include "io/analog/Curve.h"
 #include "io/analog/Analog.h"
 #include "io/display/Display.h"
 
@@ -84,6 +87,62 @@ namespace
             .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
             .newValueMin        = 1,
             .newValueMax        = 16,
+        },
+
+        //debounce time section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = BUTTONS_MAX_DEBOUNCE_TIME,
+        },
+
+        //debounce mode section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = static_cast<SysExConf::sysExParameter_t>(IO::Buttons::debounceMode_t::AMOUNT) - 1,
+        },
+
+        //long press section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = 1,
+        },
+
+        //long press midi id section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = 127,
+        },
+
+        //double tap section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = 1,
+        },
+
+        //double tap midi id section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = 127,
+        },
+
+        //repeat section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS,
+            .newValueMin        = 0,
+            .newValueMax        = 1,
+        },
+
+        //global parameters section
+        {
+            .numberOfParameters = static_cast<SysExConf::sysExParameter_t>(IO::Buttons::setting_t::AMOUNT),
+            .newValueMin        = 1,
+            .newValueMax        = BUTTONS_MAX_GESTURE_TIME,
         }
     };
 
@@ -221,6 +280,41 @@ namespace
             .numberOfParameters = MAX_NUMBER_OF_ANALOG,
             .newValueMin        = 1,
             .newValueMax        = 16,
+        },
+
+        //noise threshold section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_ANALOG,
+            .newValueMin        = 0,
+            .newValueMax        = ANALOG_NOISE_THRESHOLD_MAX,
+        },
+
+        //aftertouch type section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_ANALOG,
+            .newValueMin        = 0,
+            .newValueMax        = static_cast<SysExConf::sysExParameter_t>(IO::Analog::aftertouchType_t::AMOUNT) - 1,
+        },
+
+        //aftertouch threshold section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_ANALOG,
+            .newValueMin        = 1,
+            .newValueMax        = 127,
+        },
+
+        //global parameters section
+        {
+            .numberOfParameters = static_cast<SysExConf::sysExParameter_t>(IO::Analog::setting_t::AMOUNT),
+            .newValueMin        = 1,
+            .newValueMax        = ANALOG_AFTERTOUCH_RATE_MAX,
+        },
+
+        //response curve section
+        {
+            .numberOfParameters = MAX_NUMBER_OF_ANALOG,
+            .newValueMin        = 0,
+            .newValueMax        = static_cast<SysExConf::sysExParameter_t>(IO::AnalogCurve::curve_t::AMOUNT) - 1,
         }
     };
 
@@ -467,5 +561,20 @@ namespace
             .requestID     = SYSEX_CR_FULL_BACKUP,
             .connOpenCheck = true,
         },
+
+        {
+            .requestID     = SYSEX_CR_DIN_BANDWIDTH,
+            .connOpenCheck = true,
+        },
+
+        {
+            .requestID     = SYSEX_CR_USB_LINK_STATE,
+            .connOpenCheck = true,
+        },
+
+        {
+            .requestID     = SYSEX_CR_ANALOG_CALIBRATION,
+            .connOpenCheck = true,
+        },
     };
 }    // namespace
\ No newline at end of file
@@ -101,7 +101,7 @@ System::result_t System::onSetGlobal(Section::global_t section, size_t index, Sy
 #ifndef DIN_MIDI_SUPPORTED
             result = System::result_t::notSupported;
 #else
-            midi.setRunningStatusState(newValue);
+            hwa.setDINMIDIrunningStatusState(newValue);
             result = System::result_t::ok;
 #endif
         }
@@ -274,10 +274,15 @@ System::result_t System::onSetButtons(Section::button_t section, size_t index, S
 
     if (result == System::result_t::ok)
     {
-        if (
+        if (section == Section::button_t::global)
+            buttons.updateGestureTimes();
+        else if (
             (section == Section::button_t::type) ||
-            (section == Section::button_t::midiMessage))
+            (section == Section::button_t::midiMessage) ||
+            (section == Section::button_t::debounceMode))
             buttons.reset(index);
+        else
+            buttons.buildAction(index);
     }
 
     return result;
@@ -355,6 +360,8 @@ System::result_t System::onSetEncoders(Section::encoder_t section, size_t index,
 System::result_t System::onSetAnalog(Section::analog_t section, size_t index, SysExConf::sysExParameter_t newValue)
 {
 #ifdef ANALOG_SUPPORTED
+    bool resetNoiseThreshold = false;
+
     switch (section)
     {
     case Section::analog_t::midiID_MSB:
@@ -407,6 +414,11 @@ System::result_t System::onSetAnalog(Section::analog_t section, size_t index, Sy
     case Section::analog_t::type:
     {
         analog.debounceReset(index);
+
+        //calibrated noise threshold is measured in units of either plain or oversampled readings
+        //and isn't valid once the type switches to the other ones
+        auto oldType        = static_cast<IO::Analog::type_t>(database.read(dbSection(section), index));
+        resetNoiseThreshold = IO::Analog::isOversampled(oldType) != IO::Analog::isOversampled(static_cast<IO::Analog::type_t>(newValue));
     }
     break;
 
@@ -419,7 +431,57 @@ System::result_t System::onSetAnalog(Section::analog_t section, size_t index, Sy
     break;
     }
 
-    return database.update(dbSection(section), index, newValue) ? System::result_t::ok : System::result_t::error;
+    auto result = database.update(dbSection(section), index, newValue) ? System::result_t::ok : System::result_t::error;
+
+    if (result == System::result_t::ok)
+    {
+        switch (section)
+        {
+        case Section::analog_t::enable:
+        {
+            analog.updateScanState(index);
+        }
+        break;
+
+        case Section::analog_t::type:
+        {
+            analog.updateScanState(index);
+            analog.updateScaling(index);
+
+            if (resetNoiseThreshold)
+            {
+                database.update(Database::Section::analog_t::noiseThreshold, index, 0);
+                analog.updateNoiseThreshold(index);
+            }
+        }
+        break;
+
+        case Section::analog_t::noiseThreshold:
+        {
+            analog.updateNoiseThreshold(index);
+        }
+        break;
+
+        case Section::analog_t::global:
+        {
+            analog.updateAftertouchRate();
+        }
+        break;
+
+        case Section::analog_t::aftertouchType:
+        case Section::analog_t::aftertouchThreshold:
+            break;
+
+        default:
+        {
+            //midi id, limits, inversion, channel and response curve
+            analog.updateScaling(index);
+        }
+        break;
+        }
+    }
+
+    return result;
 #else
     return System::result_t::notSupported;
 #endif
@@ -193,6 +193,45 @@ System::result_t System::SysExDataHandler::customRequest(size_t request, CustomR
     }
     break;
 
+    case SYSEX_CR_DIN_BANDWIDTH:
+    {
+#ifdef DIN_MIDI_SUPPORTED
+        customResponse.append(system.hwa.dinMIDIbytesPerSecond());
+#else
+        result = System::result_t::notSupported;
+#endif
+    }
+    break;
+
+    case SYSEX_CR_USB_LINK_STATE:
+    {
+        uint32_t baudRate;
+        uint32_t errorCount;
+
+        if (system.hwa.usbLinkState(baudRate, errorCount))
+        {
+            //baud rate is sent in hundreds to fit into single parameter
+            customResponse.append(baudRate / 100);
+            customResponse.append(errorCount > 16383 ? 16383 : errorCount);
+        }
+        else
+        {
+            result = System::result_t::notSupported;
+        }
+    }
+    break;
+
+    case SYSEX_CR_ANALOG_CALIBRATION:
+    {
+#ifdef ANALOG_SUPPORTED
+        //no response here, thresholds are stored once the calibration is done
+        system.analog.startCalibration();
+#else
+        result = System::result_t::notSupported;
+#endif
+    }
+    break;
+
     case SYSEX_CR_FULL_BACKUP:
     {
         //no response here, just set flag internally that backup needs to be done
@@ -221,7 +260,9 @@ bool System::init()
     if (!database.init())
         return false;
 
+    buttons.init();
     encoders.init();
+    analog.init();
     display.init(true);
     touchscreen.init();
     leds.init();
@@ -278,7 +319,10 @@ void System::configureMIDI()
     midi.enableUSBMIDI();
     midi.setInputChannel(MIDI_CHANNEL_OMNI);
     midi.setNoteOffMode(isMIDIfeatureEnabled(midiFeature_t::standardNoteOff) ? MIDI::noteOffType_t::standardNoteOff : MIDI::noteOffType_t::noteOnZeroVel);
-    midi.setRunningStatusState(isMIDIfeatureEnabled(midiFeature_t::runningStatus));
+    //running status is handled on board level for DIN MIDI since
+    //outgoing stream can contain loopback data as well
+    midi.setRunningStatusState(false);
+    hwa.setDINMIDIrunningStatusState(isMIDIfeatureEnabled(midiFeature_t::runningStatus));
     midi.setChannelSendZeroStart(true);
 
 #ifdef DIN_MIDI_SUPPORTED
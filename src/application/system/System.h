@@ -101,6 +101,14 @@ class System
             midiID,
             velocity,
             midiChannel,
+            debounceTime,
+            debounceMode,
+            longPress,
+            longPressMIDIid,
+            doubleTap,
+            doubleTapMIDIid,
+            repeat,
+            global,
             AMOUNT
         };
 
@@ -130,6 +138,11 @@ class System
             upperLimit,
             upperLimit_MSB,
             midiChannel,
+            noiseThreshold,
+            aftertouchType,
+            aftertouchThreshold,
+            global,
+            curve,
             AMOUNT
         };
 
@@ -173,11 +186,14 @@ class System
         public:
         HWA() = default;
 
-        virtual bool init()                        = 0;
-        virtual bool isDigitalInputAvailable()     = 0;
-        virtual void reboot(System::reboot_t type) = 0;
-        virtual void enableDINMIDI(bool loopback)  = 0;
-        virtual void disableDINMIDI()              = 0;
+        virtual bool     init()                                                 = 0;
+        virtual bool     isDigitalInputAvailable()                              = 0;
+        virtual void     reboot(System::reboot_t type)                          = 0;
+        virtual void     enableDINMIDI(bool loopback)                           = 0;
+        virtual void     disableDINMIDI()                                       = 0;
+        virtual void     setDINMIDIrunningStatusState(bool state)               = 0;
+        virtual uint32_t dinMIDIbytesPerSecond()                                = 0;
+        virtual bool     usbLinkState(uint32_t& baudRate, uint32_t& errorCount) = 0;
     };
 
     System(HWA&             hwa,
@@ -273,7 +289,15 @@ class System
         Database::Section::button_t::midiMessage,
         Database::Section::button_t::midiID,
         Database::Section::button_t::velocity,
-        Database::Section::button_t::midiChannel
+        Database::Section::button_t::midiChannel,
+        Database::Section::button_t::debounceTime,
+        Database::Section::button_t::debounceMode,
+        Database::Section::button_t::longPress,
+        Database::Section::button_t::longPressMIDIid,
+        Database::Section::button_t::doubleTap,
+        Database::Section::button_t::doubleTapMIDIid,
+        Database::Section::button_t::repeat,
+        Database::Section::button_t::global
     };
 
     const Database::Section::encoder_t sysEx2DB_encoder[static_cast<uint8_t>(Section::encoder_t::AMOUNT)] = {
@@ -298,7 +322,12 @@ class System
         Database::Section::analog_t::lowerLimit,
         Database::Section::analog_t::upperLimit,
         Database::Section::analog_t::upperLimit,
-        Database::Section::analog_t::midiChannel
+        Database::Section::analog_t::midiChannel,
+        Database::Section::analog_t::noiseThreshold,
+        Database::Section::analog_t::aftertouchType,
+        Database::Section::analog_t::aftertouchThreshold,
+        Database::Section::analog_t::global,
+        Database::Section::analog_t::curve
     };
 
     const Database::Section::leds_t sysEx2DB_leds[static_cast<uint8_t>(Section::leds_t::AMOUNT)] = {
@@ -69,6 +69,14 @@ namespace Board
         ///
         bool readMIDI(MIDI::USBMIDIpacket_t& USBMIDIpacket);
 
+        ///
+        /// \brief Used to read multiple MIDI packets from USB interface at once.
+        /// @param [in,out] USBMIDIpackets  Pointer to array in which MIDI packets are stored.
+        /// @param [in]     maxPackets      Maximum amount of packets to read.
+        /// \returns Amount of packets read.
+        ///
+        size_t readMIDI(MIDI::USBMIDIpacket_t* USBMIDIpackets, size_t maxPackets);
+
         ///
         /// \brief Used to write MIDI data to USB interface.
         /// @param [in] USBMIDIpacket   Pointer to structure holding MIDI data to write.
@@ -123,6 +131,23 @@ namespace Board
         ///
         void setLoopbackState(uint8_t channel, bool state);
 
+        ///
+        /// \brief Used to enable or disable running status on outgoing MIDI data.
+        /// Once called, all outgoing data on specified channel (including loopback data)
+        /// is parsed as MIDI stream and emitted in complete messages. When running status is enabled,
+        /// redundant status bytes and repeated NRPN parameter select messages are omitted.
+        /// Available only on DIN MIDI channel.
+        /// @param [in] channel UART channel on MCU.
+        /// @param [in] state   New state of running status (true/enabled, false/disabled).
+        ///
+        void setMIDIrunningStatusState(uint8_t channel, bool state);
+
+        ///
+        /// \brief Returns amount of bytes sent on specified channel in last second.
+        /// @param [in] channel UART channel on MCU.
+        ///
+        uint32_t txBytesPerSecond(uint8_t channel);
+
         ///
         /// \brief Checks if all data on specified UART channel has been sent.
         /// @param [in] channel UART channel on MCU.
@@ -175,13 +200,14 @@ namespace Board
 
         ///
         /// \brief Checks if digital input data is available (encoder and button data).
-        /// Digital input data is read in ISR and stored into ring buffer.
+        /// Digital input data is read in ISR and stored into ring buffer. All readings
+        /// stored in ring buffer are retrieved at once.
         /// \returns True if data is available, false otherwise.
         ///
         bool isInputDataAvailable();
 
         ///
-        /// \brief Returns last read button state for requested button index.
+        /// \brief Returns button state from the most recent reading for requested button index.
         /// @param [in] buttonIndex Index of button which should be read.
         /// \returns True if button is pressed, false otherwise.
         ///
@@ -195,11 +221,31 @@ namespace Board
         uint8_t getEncoderPair(uint8_t buttonID);
 
         ///
-        /// \brief Checks state of requested encoder.
-        /// @param [in] encoderID       Encoder which is being checked.
-        /// \returns Pair state of the specified encoder (A and B signals stored in bits 0 and 1).
+        /// \brief Returns amount of readings retrieved on last call to isInputDataAvailable.
+        ///
+        uint8_t getNumberOfInputReadings();
+
+        ///
+        /// \brief Returns A and B signals of group of four encoders from specified reading.
+        /// @param [in] reading Index of reading, 0 being the oldest one.
+        /// @param [in] group   Index of group. Group n holds encoders 4n to 4n+3.
+        /// \returns A and B signals of k-th encoder in group stored in bits 2k+1 and 2k.
+        ///
+        uint8_t getEncoderStates(uint8_t reading, uint8_t group);
+
+        ///
+        /// \brief Returns time at which specified reading retrieved on last call to isInputDataAvailable has been taken.
+        /// @param [in] reading Index of reading, 0 being the oldest one.
+        /// \returns Time in microseconds. Overflows roughly every 71 minutes.
+        ///
+        uint32_t getInputReadingTime(uint8_t reading);
+
+        ///
+        /// \brief Returns time at which the inputs have been scanned for the last time.
+        /// Uses the same clock as getInputReadingTime.
+        /// \returns Time in microseconds. Overflows roughly every 71 minutes.
         ///
-        uint8_t getEncoderPairState(uint8_t encoderID);
+        uint32_t getInputScanTime();
 
         ///
         /// \brief Used to turn LED connected to the board on or off.
@@ -236,6 +282,45 @@ namespace Board
         /// \returns True if there is a new reading for specified analog index.
         ///
         bool analogValue(uint8_t analogID, uint16_t& value);
+
+        ///
+        /// \brief Enables or disables reading of specified analog input.
+        /// Disabled inputs are skipped during ADC scan so that the enabled ones are read more often.
+        /// All inputs are enabled by default.
+        /// @param [in] analogID    Analog index for which the scan state is being changed.
+        /// @param [in] state       New scan state (true/enabled, false/disabled).
+        ///
+        void setAnalogScanState(uint8_t analogID, bool state);
+
+        ///
+        /// \brief Enables or disables oversampling of specified analog input.
+        /// Readings of oversampled inputs are sums of ANALOG_OVERSAMPLING_COUNT
+        /// consecutive ADC readings and therefore fill 14-bit range.
+        /// All inputs are read without oversampling by default.
+        /// @param [in] analogID    Analog index for which the oversampling state is being changed.
+        /// @param [in] state       New oversampling state (true/enabled, false/disabled).
+        ///
+        void setAnalogOversamplingState(uint8_t analogID, bool state);
+
+        ///
+        /// \brief Enables or disables strike peak detection on specified analog input.
+        /// Inputs with peak detection enabled are sampled continuously once the strike is detected
+        /// and only the peak reading of the strike is reported. After that, current pressure is reported
+        /// while the input is pressed and 0 is reported on release. Nothing is reported while the input is idle.
+        /// Peak detection is disabled on all inputs by default.
+        /// @param [in] analogID    Analog index for which the peak detection state is being changed.
+        /// @param [in] state       New peak detection state (true/enabled, false/disabled).
+        ///
+        void setAnalogPeakDetectionState(uint8_t analogID, bool state);
+
+        ///
+        /// \brief Retrieves all new ADC readings of enabled analog inputs.
+        /// @param [in,out] analogIDs   Array in which analog indexes with new readings are stored.
+        /// @param [in,out] values      Array in which new readings are stored.
+        /// @param [in]     maxValues   Maximum amount of readings to retrieve.
+        /// \returns Amount of retrieved readings.
+        ///
+        size_t analogNewValues(uint8_t* analogIDs, uint16_t* values, size_t maxValues);
     }    // namespace io
 
     namespace NVM
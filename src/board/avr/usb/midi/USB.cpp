@@ -111,36 +111,40 @@ namespace Board
     namespace USB
     {
         bool readMIDI(MIDI::USBMIDIpacket_t& USBMIDIpacket)
+        {
+            return readMIDI(&USBMIDIpacket, 1) == 1;
+        }
+
+        size_t readMIDI(MIDI::USBMIDIpacket_t* USBMIDIpackets, size_t maxPackets)
         {
             //device must be connected and configured for the task to run
             if (USB_DeviceState != DEVICE_STATE_Configured)
-                return false;
+                return 0;
 
             //select the MIDI OUT stream
             Endpoint_SelectEndpoint(MIDI_STREAM_OUT_EPADDR);
 
-            //check if a MIDI command has been received
-            if (Endpoint_IsOUTReceived())
+            size_t count = 0;
+
+            //read as many MIDI commands as received
+            while ((count < maxPackets) && Endpoint_IsOUTReceived())
             {
                 //read the MIDI event packet from the endpoint
-                Endpoint_Read_Stream_LE(&USBMIDIpacket, sizeof(USBMIDIpacket), NULL);
+                Endpoint_Read_Stream_LE(&USBMIDIpackets[count++], sizeof(MIDI::USBMIDIpacket_t), NULL);
 
                 //if the endpoint is now empty, clear the bank
                 if (!(Endpoint_BytesInEndpoint()))
                     Endpoint_ClearOUT();    //clear the endpoint ready for new packet
+            }
 
 #ifdef FW_APP
 #ifdef LED_INDICATORS
+            if (count)
                 Board::detail::io::indicateMIDItraffic(MIDI::interface_t::usb, Board::detail::midiTrafficDirection_t::incoming);
 #endif
 #endif
 
-                return true;
-            }
-            else
-            {
-                return false;
-            }
+            return count;
         }
 
         bool writeMIDI(MIDI::USBMIDIpacket_t& USBMIDIpacket)
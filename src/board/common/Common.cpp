@@ -105,6 +105,10 @@ namespace Board
             break;
 
         case rebootType_t::rebootBtldr:
+#if !defined(USB_MIDI_SUPPORTED) && defined(FW_APP)
+            //bootloader communicates with usb link using default baud rate
+            OpenDeckMIDIformat::resetBaudRate(UART_CHANNEL_USB_LINK);
+#endif
             detail::bootloader::enableSWtrigger();
             break;
         }
@@ -45,6 +45,34 @@ limitations under the License.
 #define ANALOG_IN_BUFFER_SIZE (NUMBER_OF_MUX_INPUTS * NUMBER_OF_MUX)
 #endif
 
+///
+/// \brief Amount of ADC readings summed into single reading of oversampled analog input.
+/// Sum of the readings fills 14-bit range, which gives two additional bits
+/// of effective resolution on 10-bit ADC and one additional bit on 12-bit ADC.
+///
+#ifdef ADC_12_BIT
+#define ANALOG_OVERSAMPLING_COUNT 4
+#else
+#define ANALOG_OVERSAMPLING_COUNT 16
+#endif
+
+///
+/// \brief Thresholds in raw ADC units used to detect strike and release on FSR inputs.
+///
+#ifdef ADC_12_BIT
+#define ANALOG_FSR_ONSET_THRESHOLD   160
+#define ANALOG_FSR_RELEASE_THRESHOLD 80
+#else
+#define ANALOG_FSR_ONSET_THRESHOLD   40
+#define ANALOG_FSR_RELEASE_THRESHOLD 20
+#endif
+
+///
+/// \brief Maximum amount of ADC readings taken after the strike is detected on FSR input
+/// before its peak is reported. While the peak is searched for, other inputs aren't read.
+///
+#define ANALOG_FSR_PEAK_WINDOW 32
+
 ///
 /// \brief Size of ring buffer used to store all digital input readings.
 /// Once digital input array is full (all inputs are read), index within ring buffer
@@ -52,6 +80,12 @@ limitations under the License.
 ///
 #define DIGITAL_IN_BUFFER_SIZE 5
 
+///
+/// \brief Time in microseconds between two digital input readings.
+/// Matches the period of main timer interrupt in which the inputs are read.
+///
+#define DIGITAL_IN_SCAN_PERIOD_US 500
+
 ///
 /// \brief Time in milliseconds during which MIDI event indicators on board are on when MIDI event happens.
 ///
@@ -22,6 +22,7 @@ limitations under the License.
 #include "core/src/general/Atomic.h"
 #include "board/Board.h"
 #include "board/Internal.h"
+#include "common/FSRPeakDetector/FSRPeakDetector.h"
 #include "Pins.h"
 
 ///
@@ -29,11 +30,133 @@ limitations under the License.
 ///
 #define NEW_READING_FLAG 0x8000
 
+///
+/// \brief Size of array used to store scan state of all analog inputs.
+/// One bit represents single analog input.
+///
+#define ANALOG_SCAN_ARRAY_SIZE ((ANALOG_IN_BUFFER_SIZE + 7) / 8)
+
 namespace
 {
     uint8_t           analogIndex;
     volatile uint16_t analogBuffer[ANALOG_IN_BUFFER_SIZE];
 
+    ///
+    /// \brief Holds the scan state of all analog inputs, indexed by ADC buffer index.
+    /// Bit set means that the input is skipped during ADC scan.
+    /// All inputs are scanned by default.
+    ///
+    volatile uint8_t analogScanDisabled[ANALOG_SCAN_ARRAY_SIZE];
+
+    ///
+    /// \brief Holds the oversampling state of all analog inputs, indexed by ADC buffer index.
+    /// Bit set means that ANALOG_OVERSAMPLING_COUNT readings are summed for the input.
+    ///
+    volatile uint8_t analogOversampled[ANALOG_SCAN_ARRAY_SIZE];
+
+    ///
+    /// \brief Holds the peak detection state of all analog inputs, indexed by ADC buffer index.
+    /// Bit set means that strike peak is detected on the input.
+    ///
+    volatile uint8_t analogPeakDetection[ANALOG_SCAN_ARRAY_SIZE];
+
+    ///
+    /// \brief Holds the pressed state of all analog inputs with peak detection enabled.
+    ///
+    volatile uint8_t analogPressed[ANALOG_SCAN_ARRAY_SIZE];
+
+    ///
+    /// \brief Sum and amount of readings collected so far for currently active input.
+    ///
+    uint16_t analogSampleSum;
+    uint8_t  analogSampleCount;
+
+    FSRPeakDetector peakDetector(ANALOG_FSR_ONSET_THRESHOLD, ANALOG_FSR_RELEASE_THRESHOLD, ANALOG_FSR_PEAK_WINDOW);
+
+    inline bool isScanned(uint8_t index)
+    {
+        return !BIT_READ(analogScanDisabled[index / 8], index % 8);
+    }
+
+    inline uint8_t samplesPerReading(uint8_t index)
+    {
+        return BIT_READ(analogOversampled[index / 8], index % 8) ? ANALOG_OVERSAMPLING_COUNT : 1;
+    }
+
+    ///
+    /// \brief Passes the reading of currently active input with peak detection enabled to peak detector.
+    /// \returns True once the next input can be selected.
+    ///
+    inline bool storePeakReading(uint16_t adcValue)
+    {
+        //previous report hasn't been retrieved yet - don't overwrite it since peaks and releases can't be lost
+        if (analogBuffer[analogIndex] & NEW_READING_FLAG)
+            return true;
+
+        bool     pressed = BIT_READ(analogPressed[analogIndex / 8], analogIndex % 8);
+        uint16_t value;
+
+        switch (peakDetector.process(pressed, adcValue, value))
+        {
+        case FSRPeakDetector::result_t::sampling:
+            return false;
+
+        case FSRPeakDetector::result_t::report:
+        {
+            BIT_WRITE(analogPressed[analogIndex / 8], analogIndex % 8, pressed);
+            analogBuffer[analogIndex] = value;
+            analogBuffer[analogIndex] |= NEW_READING_FLAG;
+        }
+        break;
+
+        default:
+            break;
+        }
+
+        return true;
+    }
+
+    ///
+    /// \brief Stores the reading of currently active input.
+    /// \returns True once all the readings for the input are collected and the next input can be selected.
+    ///
+    inline bool storeReading(uint16_t adcValue)
+    {
+        if (BIT_READ(analogPeakDetection[analogIndex / 8], analogIndex % 8))
+            return storePeakReading(adcValue);
+
+        analogSampleSum += adcValue;
+
+        //stay on the same input until all readings for oversampled input are collected
+        if (++analogSampleCount < samplesPerReading(analogIndex))
+            return false;
+
+        analogBuffer[analogIndex] = analogSampleSum;
+        analogBuffer[analogIndex] |= NEW_READING_FLAG;
+        analogSampleSum   = 0;
+        analogSampleCount = 0;
+
+        return true;
+    }
+
+    ///
+    /// \brief Returns ADC buffer index of the next analog input which should be read.
+    /// If no input is scanned, current index is returned.
+    ///
+    inline uint8_t nextAnalogIndex(uint8_t index)
+    {
+        for (int i = 0; i < ANALOG_IN_BUFFER_SIZE; i++)
+        {
+            if (++index == ANALOG_IN_BUFFER_SIZE)
+                index = 0;
+
+            if (isScanned(index))
+                break;
+        }
+
+        return index;
+    }
+
 #ifdef NUMBER_OF_MUX
     uint8_t activeMux;
     uint8_t activeMuxInput;
@@ -78,6 +201,99 @@ namespace Board
 
             return false;
         }
+
+        void setAnalogScanState(uint8_t analogID, bool state)
+        {
+            if (analogID >= MAX_NUMBER_OF_ANALOG)
+                return;
+
+            analogID = detail::map::adcIndex(analogID);
+
+            ATOMIC_SECTION
+            {
+                BIT_WRITE(analogScanDisabled[analogID / 8], analogID % 8, !state);
+
+                //drop the stale reading so that the input isn't reported once enabled again
+                if (!state)
+                    analogBuffer[analogID] &= ~NEW_READING_FLAG;
+            }
+        }
+
+        void setAnalogOversamplingState(uint8_t analogID, bool state)
+        {
+            if (analogID >= MAX_NUMBER_OF_ANALOG)
+                return;
+
+            analogID = detail::map::adcIndex(analogID);
+
+            ATOMIC_SECTION
+            {
+                if (BIT_READ(analogOversampled[analogID / 8], analogID % 8) != state)
+                {
+                    BIT_WRITE(analogOversampled[analogID / 8], analogID % 8, state);
+
+                    //reading in the buffer was made with the old state and isn't in the expected range anymore
+                    analogBuffer[analogID] &= ~NEW_READING_FLAG;
+                }
+            }
+        }
+
+        void setAnalogPeakDetectionState(uint8_t analogID, bool state)
+        {
+            if (analogID >= MAX_NUMBER_OF_ANALOG)
+                return;
+
+            analogID = detail::map::adcIndex(analogID);
+
+            ATOMIC_SECTION
+            {
+                if (BIT_READ(analogPeakDetection[analogID / 8], analogID % 8) != state)
+                {
+                    BIT_WRITE(analogPeakDetection[analogID / 8], analogID % 8, state);
+                    BIT_WRITE(analogPressed[analogID / 8], analogID % 8, false);
+
+                    //start over on the input in any case
+                    if (analogID == analogIndex)
+                    {
+                        peakDetector.reset();
+                        analogSampleSum   = 0;
+                        analogSampleCount = 0;
+                    }
+
+                    analogBuffer[analogID] &= ~NEW_READING_FLAG;
+                }
+            }
+        }
+
+        size_t analogNewValues(uint8_t* analogIDs, uint16_t* values, size_t maxValues)
+        {
+            size_t count = 0;
+
+            for (uint8_t i = 0; (i < MAX_NUMBER_OF_ANALOG) && (count < maxValues); i++)
+            {
+                uint8_t index = detail::map::adcIndex(i);
+
+                if (!isScanned(index))
+                    continue;
+
+                uint16_t value;
+
+                ATOMIC_SECTION
+                {
+                    value = analogBuffer[index];
+                    analogBuffer[index] &= ~NEW_READING_FLAG;
+                }
+
+                if (value & NEW_READING_FLAG)
+                {
+                    analogIDs[count] = i;
+                    values[count]    = value & ~NEW_READING_FLAG;
+                    count++;
+                }
+            }
+
+            return count;
+        }
     }    // namespace io
 
     namespace detail
@@ -86,54 +302,43 @@ namespace Board
         {
             void adc(uint16_t adcValue)
             {
-                static bool firstReading = false;
+                //first reading after the input switch is discarded
+                static bool firstReading = true;
 
-                firstReading = !firstReading;
-
-                if (!firstReading)
+                if (firstReading)
+                {
+                    firstReading = false;
+                }
+                else
                 {
 #ifdef NUMBER_OF_MUX
                     detail::io::dischargeMux();
 #endif
 
-                    analogBuffer[analogIndex] = adcValue;
-                    analogBuffer[analogIndex] |= NEW_READING_FLAG;
-                    analogIndex++;
-#ifdef NUMBER_OF_MUX
-                    activeMuxInput++;
+                    if (storeReading(adcValue))
+                    {
+                        firstReading = true;
 
-                    bool switchMux = (activeMuxInput == NUMBER_OF_MUX_INPUTS);
+                        //skip inputs which aren't scanned
+                        analogIndex = nextAnalogIndex(analogIndex);
 
-                    if (switchMux)
-#else
-                    if (analogIndex == MAX_NUMBER_OF_ANALOG)
-#endif
-                    {
 #ifdef NUMBER_OF_MUX
-                        activeMuxInput = 0;
-                        activeMux++;
+                        uint8_t mux    = analogIndex / NUMBER_OF_MUX_INPUTS;
+                        activeMuxInput = analogIndex % NUMBER_OF_MUX_INPUTS;
 
-                        if (activeMux == NUMBER_OF_MUX)
+                        if (mux != activeMux)
                         {
-                            activeMux = 0;
-#endif
-                            analogIndex = 0;
-#ifdef NUMBER_OF_MUX
-                        }
-#endif
+                            activeMux = mux;
 
-#ifdef NUMBER_OF_MUX
-                        //switch to next mux once all mux inputs are read
-                        core::adc::setChannel(Board::detail::map::adcChannel(activeMux));
-#endif
-                    }
+                            //switch to next mux once all scanned mux inputs are read
+                            core::adc::setChannel(Board::detail::map::adcChannel(activeMux));
+                        }
 
-//always switch to next read pin
-#ifdef NUMBER_OF_MUX
-                    setMuxInput();
+                        setMuxInput();
 #else
-                    core::adc::setChannel(Board::detail::map::adcChannel(analogIndex));
+                        core::adc::setChannel(Board::detail::map::adcChannel(analogIndex));
 #endif
+                    }
                 }
 
 #ifdef NUMBER_OF_MUX
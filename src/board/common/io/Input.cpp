@@ -26,10 +26,33 @@ limitations under the License.
 #include "core/src/general/Atomic.h"
 #include "Pins.h"
 
+//readings in which encoders have moved are tracked in 8-bit masks
+static_assert(DIGITAL_IN_BUFFER_SIZE <= 8, "Digital input buffer can't hold more than 8 readings.");
+
 namespace
 {
     volatile uint8_t digitalInBuffer[DIGITAL_IN_BUFFER_SIZE][DIGITAL_IN_ARRAY_SIZE];
-    uint8_t          digitalInBufferReadOnly[DIGITAL_IN_ARRAY_SIZE];
+
+    ///
+    /// \brief All readings retrieved from ring buffer on last check, oldest first.
+    ///
+    uint8_t digitalInBufferReadOnly[DIGITAL_IN_BUFFER_SIZE][DIGITAL_IN_ARRAY_SIZE];
+
+    ///
+    /// \brief Time in microseconds at which each reading in ring buffer has been taken.
+    ///
+    volatile uint32_t digitalInTime[DIGITAL_IN_BUFFER_SIZE];
+    uint32_t          digitalInTimeReadOnly[DIGITAL_IN_BUFFER_SIZE];
+
+    ///
+    /// \brief Time in microseconds at which the inputs are read, incremented on each scan.
+    ///
+    volatile uint32_t scanTime;
+
+    ///
+    /// \brief Amount of readings stored in digitalInBufferReadOnly.
+    ///
+    uint8_t digitalInReadings;
 
 #ifdef NUMBER_OF_BUTTON_COLUMNS
     volatile uint8_t activeInColumn;
@@ -127,6 +150,26 @@ namespace
         }
     }
 #endif
+
+    ///
+    /// \brief Returns button state from specified reading in digitalInBufferReadOnly.
+    ///
+    bool buttonState(uint8_t reading, uint8_t buttonID)
+    {
+        buttonID = Board::detail::map::buttonIndex(buttonID);
+
+#ifdef NUMBER_OF_BUTTON_COLUMNS
+        uint8_t row    = buttonID / NUMBER_OF_BUTTON_COLUMNS;
+        uint8_t column = buttonID % NUMBER_OF_BUTTON_COLUMNS;
+
+        return BIT_READ(digitalInBufferReadOnly[reading][column], row);
+#else
+        uint8_t arrayIndex  = buttonID / 8;
+        uint8_t buttonIndex = buttonID - 8 * arrayIndex;
+
+        return BIT_READ(digitalInBufferReadOnly[reading][arrayIndex], buttonIndex);
+#endif
+    }
 }    // namespace
 
 namespace Board
@@ -138,19 +181,11 @@ namespace Board
             if (buttonID >= MAX_NUMBER_OF_BUTTONS)
                 return false;
 
-            buttonID = detail::map::buttonIndex(buttonID);
-
-#ifdef NUMBER_OF_BUTTON_COLUMNS
-            uint8_t row    = buttonID / NUMBER_OF_BUTTON_COLUMNS;
-            uint8_t column = buttonID % NUMBER_OF_BUTTON_COLUMNS;
-
-            return BIT_READ(digitalInBufferReadOnly[column], row);
-#else
-            uint8_t arrayIndex  = buttonID / 8;
-            uint8_t buttonIndex = buttonID - 8 * arrayIndex;
+            if (!digitalInReadings)
+                return false;
 
-            return BIT_READ(digitalInBufferReadOnly[arrayIndex], buttonIndex);
-#endif
+            //buttons only need the most recent reading
+            return buttonState(digitalInReadings - 1, buttonID);
         }
 
         uint8_t getEncoderPair(uint8_t buttonID)
@@ -168,28 +203,64 @@ namespace Board
 #endif
         }
 
-        uint8_t getEncoderPairState(uint8_t encoderID)
+        uint8_t getNumberOfInputReadings()
         {
-#ifdef NUMBER_OF_BUTTON_COLUMNS
-            uint8_t column = encoderID % NUMBER_OF_BUTTON_COLUMNS;
-            uint8_t row    = (encoderID / NUMBER_OF_BUTTON_COLUMNS) * 2;
+            return digitalInReadings;
+        }
 
-            uint8_t buttonID;
+        uint8_t getEncoderStates(uint8_t reading, uint8_t group)
+        {
+            if (reading >= digitalInReadings)
+                return 0;
 
-            buttonID = row * NUMBER_OF_BUTTON_COLUMNS + column;
+            uint8_t states = 0;
 
-            uint8_t pairState = getButtonState(buttonID);
-            pairState <<= 1;
-            pairState |= getButtonState(buttonID + NUMBER_OF_BUTTON_COLUMNS);
-#else
-            uint8_t buttonID = encoderID * 2;
+            for (int i = 0; i < 4; i++)
+            {
+                uint8_t encoderID = group * 4 + i;
 
-            uint8_t pairState = getButtonState(buttonID);
-            pairState <<= 1;
-            pairState |= getButtonState(buttonID + 1);
+#ifdef NUMBER_OF_BUTTON_COLUMNS
+                uint8_t column = encoderID % NUMBER_OF_BUTTON_COLUMNS;
+                uint8_t row    = (encoderID / NUMBER_OF_BUTTON_COLUMNS) * 2;
+
+                uint8_t buttonA = row * NUMBER_OF_BUTTON_COLUMNS + column;
+                uint8_t buttonB = buttonA + NUMBER_OF_BUTTON_COLUMNS;
+#else
+                uint8_t buttonA = encoderID * 2;
+                uint8_t buttonB = buttonA + 1;
 #endif
 
-            return pairState;
+                if (buttonB >= MAX_NUMBER_OF_BUTTONS)
+                    break;
+
+                uint8_t pairState = buttonState(reading, buttonA);
+                pairState <<= 1;
+                pairState |= buttonState(reading, buttonB);
+
+                states |= pairState << (i * 2);
+            }
+
+            return states;
+        }
+
+        uint32_t getInputReadingTime(uint8_t reading)
+        {
+            if (reading >= digitalInReadings)
+                return 0;
+
+            return digitalInTimeReadOnly[reading];
+        }
+
+        uint32_t getInputScanTime()
+        {
+            uint32_t time;
+
+            ATOMIC_SECTION
+            {
+                time = scanTime;
+            }
+
+            return time;
         }
 
         bool isInputDataAvailable()
@@ -198,13 +269,22 @@ namespace Board
             {
                 ATOMIC_SECTION
                 {
-                    if (++dIn_tail == DIGITAL_IN_BUFFER_SIZE)
-                        dIn_tail = 0;
+                    //retrieve all readings at once so that no reading is lost when main loop is slow
+                    digitalInReadings = 0;
 
-                    for (int i = 0; i < DIGITAL_IN_ARRAY_SIZE; i++)
-                        digitalInBufferReadOnly[i] = digitalInBuffer[dIn_tail][i];
+                    while (dIn_count)
+                    {
+                        if (++dIn_tail == DIGITAL_IN_BUFFER_SIZE)
+                            dIn_tail = 0;
 
-                    dIn_count--;
+                        for (int i = 0; i < DIGITAL_IN_ARRAY_SIZE; i++)
+                            digitalInBufferReadOnly[digitalInReadings][i] = digitalInBuffer[dIn_tail][i];
+
+                        digitalInTimeReadOnly[digitalInReadings] = digitalInTime[dIn_tail];
+
+                        digitalInReadings++;
+                        dIn_count--;
+                    }
                 }
 
                 return true;
@@ -220,12 +300,15 @@ namespace Board
         {
             void checkDigitalInputs()
             {
+                scanTime += DIGITAL_IN_SCAN_PERIOD_US;
+
                 if (dIn_count < DIGITAL_IN_BUFFER_SIZE)
                 {
                     if (++dIn_head == DIGITAL_IN_BUFFER_SIZE)
                         dIn_head = 0;
 
                     storeDigitalIn();
+                    digitalInTime[dIn_head] = scanTime;
 
                     dIn_count++;
                 }
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "board/Board.h"
 #include "board/Internal.h"
+#include "core/src/general/Timing.h"
 
 //stub functions used so that firmware can be compiled without resorting to ifdef mess if
 //some IO module isn't supported
@@ -41,11 +42,28 @@ namespace Board
             return 0;
         }
 
-        __attribute__((weak)) uint8_t getEncoderPairState(uint8_t encoderID)
+        __attribute__((weak)) uint8_t getNumberOfInputReadings()
         {
             return 0;
         }
 
+        __attribute__((weak)) uint8_t getEncoderStates(uint8_t reading, uint8_t group)
+        {
+            return 0;
+        }
+
+        //without digital inputs there is no scan clock - use run time so that time still advances
+
+        __attribute__((weak)) uint32_t getInputReadingTime(uint8_t reading)
+        {
+            return core::timing::currentRunTimeMs() * 1000;
+        }
+
+        __attribute__((weak)) uint32_t getInputScanTime()
+        {
+            return core::timing::currentRunTimeMs() * 1000;
+        }
+
         __attribute__((weak)) void writeLEDstate(uint8_t ledID, bool state)
         {
         }
@@ -20,14 +20,27 @@ limitations under the License.
 
 #include "board/Board.h"
 #include "board/Internal.h"
-#include "core/src/general/RingBuffer.h"
+#include "common/SPSCRingBuffer/SPSCRingBuffer.h"
 #include "core/src/general/Helpers.h"
+#include "core/src/general/Atomic.h"
+#include "core/src/general/Timing.h"
 #include "MCU.h"
 
+#if defined(DIN_MIDI_SUPPORTED) && defined(FW_APP)
+#include "common/DINMIDIencoder/DINMIDIencoder.h"
+#define USE_MIDI_ENCODER
+#endif
+
 //generic UART driver, arch-independent
 
-#define TX_BUFFER_SIZE MIDI_SYSEX_ARRAY_SIZE
-#define RX_BUFFER_SIZE MIDI_SYSEX_ARRAY_SIZE
+//buffer size must be power of two - use the smallest one which can hold entire sysex message
+#if MIDI_SYSEX_ARRAY_SIZE <= 64
+#define TX_BUFFER_SIZE 64
+#define RX_BUFFER_SIZE 64
+#else
+#define TX_BUFFER_SIZE 128
+#define RX_BUFFER_SIZE 128
+#endif
 
 namespace
 {
@@ -49,13 +62,87 @@ namespace
 
     ///
     /// \brief Buffer in which outgoing UART data is stored.
+    /// Consumed in TX interrupt. Filled in application, and in RX interrupt when
+    /// loopback is enabled - in that case application writes with interrupts disabled.
     ///
-    core::RingBuffer<uint8_t, TX_BUFFER_SIZE> txBuffer[MAX_UART_INTERFACES];
+    SPSCRingBuffer<uint8_t, TX_BUFFER_SIZE> txBuffer[MAX_UART_INTERFACES];
 
     ///
     /// \brief Buffer in which incoming UART data is stored.
+    /// Filled in RX interrupt and consumed in application.
+    ///
+    SPSCRingBuffer<uint8_t, RX_BUFFER_SIZE> rxBuffer[MAX_UART_INTERFACES];
+
+    ///
+    /// \brief Run time in milliseconds at which current TX byte counting window has started.
+    ///
+    volatile uint32_t txWindowStartTime[MAX_UART_INTERFACES];
+
+    ///
+    /// \brief Amount of bytes sent in current and previous one-second window.
+    ///
+    volatile uint32_t txBytesCurrentWindow[MAX_UART_INTERFACES];
+    volatile uint32_t txBytesLastWindow[MAX_UART_INTERFACES];
+
+#ifdef USE_MIDI_ENCODER
+    ///
+    /// \brief Flag determining whether outgoing data is passed through MIDI encoder.
+    ///
+    volatile bool midiEncoderEnabled[MAX_UART_INTERFACES];
+
+    ///
+    /// \brief Encoders used to track running status of outgoing MIDI stream.
+    ///
+    DINMIDIencoder midiEncoder[MAX_UART_INTERFACES];
+#endif
+
+    ///
+    /// \brief Updates the amount of transmitted bytes for specified channel.
+    /// Called from TX interrupt once the byte has been taken from the TX buffer.
+    /// @param [in] channel     UART channel on MCU.
     ///
-    core::RingBuffer<uint8_t, RX_BUFFER_SIZE> rxBuffer[MAX_UART_INTERFACES];
+    void countTxByte(uint8_t channel)
+    {
+        uint32_t elapsed = core::timing::currentRunTimeMs() - txWindowStartTime[channel];
+
+        if (elapsed >= 1000)
+        {
+            //if there was no data for more than a full window, last window was empty
+            txBytesLastWindow[channel]    = elapsed >= 2000 ? 0 : txBytesCurrentWindow[channel];
+            txBytesCurrentWindow[channel] = 0;
+            txWindowStartTime[channel]    = core::timing::currentRunTimeMs();
+        }
+
+        txBytesCurrentWindow[channel]++;
+    }
+
+    ///
+    /// \brief Stores single byte of outgoing data in TX buffer.
+    /// If MIDI encoder is enabled, data is passed through it first.
+    /// @param [in] channel     UART channel on MCU.
+    /// @param [in] data        Byte to store.
+    /// \returns True on success, false if there isn't enough space in TX buffer.
+    ///
+    bool storeOutgoingData(uint8_t channel, uint8_t data)
+    {
+#ifdef USE_MIDI_ENCODER
+        if (midiEncoderEnabled[channel])
+        {
+            //encoder state must be updated only once its entire output can be stored
+            if (txBuffer[channel].freeSpace() < DINMIDIencoder::MAX_OUTPUT_SIZE)
+                return false;
+
+            uint8_t output[DINMIDIencoder::MAX_OUTPUT_SIZE];
+            size_t  size = midiEncoder[channel].encode(DINMIDIencoder::source_t::local, data, output);
+
+            txBuffer[channel].write(output, size);
+
+            return true;
+        }
+#endif
+
+        return txBuffer[channel].insert(data);
+    }
 
     ///
     /// \brief Starts the process of transmitting the data from UART TX buffer to UART interface.
@@ -84,6 +171,47 @@ namespace Board
             loopbackEnabled[channel] = state;
         }
 
+        void setMIDIrunningStatusState(uint8_t channel, bool state)
+        {
+            if (channel >= MAX_UART_INTERFACES)
+                return;
+
+#ifdef USE_MIDI_ENCODER
+            ATOMIC_SECTION
+            {
+                midiEncoder[channel].setOptimizationState(state);
+                midiEncoderEnabled[channel] = true;
+            }
+#endif
+        }
+
+        uint32_t txBytesPerSecond(uint8_t channel)
+        {
+            if (channel >= MAX_UART_INTERFACES)
+                return 0;
+
+            uint32_t elapsed;
+            uint32_t current;
+            uint32_t last;
+
+            ATOMIC_SECTION
+            {
+                elapsed = core::timing::currentRunTimeMs() - txWindowStartTime[channel];
+                current = txBytesCurrentWindow[channel];
+                last    = txBytesLastWindow[channel];
+            }
+
+            //windows are rotated only once new data is sent
+            //if the current window has expired, it holds the latest complete count
+            if (elapsed >= 2000)
+                return 0;
+
+            if (elapsed >= 1000)
+                return current;
+
+            return last;
+        }
+
         bool deInit(uint8_t channel)
         {
             if (channel >= MAX_UART_INTERFACES)
@@ -96,6 +224,11 @@ namespace Board
                 rxBuffer[channel].reset();
                 txBuffer[channel].reset();
 
+#ifdef USE_MIDI_ENCODER
+                //receiving side can't be assumed to hold any running status after this
+                midiEncoder[channel].reset();
+#endif
+
                 txDone[channel]      = true;
                 initialized[channel] = false;
 
@@ -145,8 +278,23 @@ namespace Board
             if (channel >= MAX_UART_INTERFACES)
                 return false;
 
-            while (!txBuffer[channel].insert(data))
-                ;
+            bool written = false;
+
+            while (!written)
+            {
+                if (loopbackEnabled[channel])
+                {
+                    //rx interrupt writes to tx buffer (and encoder) as well
+                    ATOMIC_SECTION
+                    {
+                        written = storeOutgoingData(channel, data);
+                    }
+                }
+                else
+                {
+                    written = storeOutgoingData(channel, data);
+                }
+            }
 
             uartTransmitStart(channel);
 
@@ -183,7 +331,25 @@ namespace Board
                 }
                 else
                 {
-                    if (txBuffer[channel].insert(data))
+#ifdef USE_MIDI_ENCODER
+                    uint8_t output[DINMIDIencoder::MAX_OUTPUT_SIZE] = { data };
+                    size_t  size                                    = 1;
+
+                    if (midiEncoderEnabled[channel])
+                    {
+                        //encoder state must be updated only once its entire output can be stored
+                        //drop the incoming byte otherwise
+                        if (txBuffer[channel].freeSpace() < DINMIDIencoder::MAX_OUTPUT_SIZE)
+                            return;
+
+                        size = midiEncoder[channel].encode(DINMIDIencoder::source_t::loopback, data, output);
+                    }
+#else
+                    uint8_t output[1] = { data };
+                    size_t  size      = 1;
+#endif
+
+                    if (txBuffer[channel].write(output, size))
                     {
                         Board::detail::UART::ll::enableDataEmptyInt(channel);
 
@@ -201,6 +367,8 @@ namespace Board
             {
                 if (txBuffer[channel].remove(data))
                 {
+                    countTxByte(channel);
+
 #ifndef USB_LINK_MCU
 #ifdef FW_APP
 #ifdef LED_INDICATORS
@@ -19,7 +19,7 @@ limitations under the License.
 #include "board/common/usb/descriptors/Descriptors.h"
 #include "usbd_core.h"
 #include "midi/src/MIDI.h"
-#include "core/src/general/RingBuffer.h"
+#include "common/SPSCRingBuffer/SPSCRingBuffer.h"
 #include "core/src/general/Atomic.h"
 #include "core/src/general/Timing.h"
 #include "core/src/general/StringBuilder.h"
@@ -36,17 +36,25 @@ limitations under the License.
 
 /// @}
 
+///
+/// \brief Size of single USB MIDI event packet in bytes.
+///
+#define USB_MIDI_PACKET_SIZE 4
+
 namespace
 {
     USBD_HandleTypeDef hUsbDeviceFS;
     volatile bool      TxDone;
-    volatile uint8_t   rxBuffer[RX_BUFFER_SIZE_USB];
+    volatile uint32_t  rxBuffer[RX_BUFFER_SIZE_USB / USB_MIDI_PACKET_SIZE];
     volatile bool      initialized;
 
     //rxBuffer is overriden every time RxCallback is called
     //save results in ring buffer and remove them as needed in readMIDI
-    //not really the most optimized way, however, we are not in AVR land anymore
-    core::RingBuffer<uint8_t, RX_BUFFER_SIZE_RING> rxBufferRing;
+    //ring buffer is filled only in RxCallback and emptied only in readMIDI so no locking is needed
+    //each element holds entire usb midi event packet so that packets can be read directly into caller's array
+    SPSCRingBuffer<MIDI::USBMIDIpacket_t, RX_BUFFER_SIZE_RING / USB_MIDI_PACKET_SIZE> rxBufferRing;
+
+    static_assert(sizeof(MIDI::USBMIDIpacket_t) == USB_MIDI_PACKET_SIZE, "Invalid USB MIDI packet size.");
 
     uint8_t initCallback(USBD_HandleTypeDef* pdev, uint8_t cfgidx)
     {
@@ -76,8 +84,8 @@ namespace
     {
         uint32_t count = ((PCD_HandleTypeDef*)pdev->pData)->OUT_ep[epnum].xfer_count;
 
-        for (uint32_t i = 0; i < count; i++)
-            rxBufferRing.insert(rxBuffer[i]);
+        //usb midi transfers always consist of whole event packets
+        rxBufferRing.write(reinterpret_cast<const MIDI::USBMIDIpacket_t*>(const_cast<uint32_t*>(rxBuffer)), count / USB_MIDI_PACKET_SIZE);
 
         USBD_LL_PrepareReceive(pdev, MIDI_STREAM_OUT_EPADDR, (uint8_t*)(rxBuffer), RX_BUFFER_SIZE_USB);
         return 0;
@@ -189,28 +197,21 @@ namespace Board
     {
         bool readMIDI(MIDI::USBMIDIpacket_t& USBMIDIpacket)
         {
-            bool returnValue = false;
-
-            if (rxBufferRing.count() >= 4)
-            {
-                rxBufferRing.remove(USBMIDIpacket.Event);
-                rxBufferRing.remove(USBMIDIpacket.Data1);
-                rxBufferRing.remove(USBMIDIpacket.Data2);
-                rxBufferRing.remove(USBMIDIpacket.Data3);
+            return readMIDI(&USBMIDIpacket, 1) == 1;
+        }
 
-                returnValue = true;
-            }
+        size_t readMIDI(MIDI::USBMIDIpacket_t* USBMIDIpackets, size_t maxPackets)
+        {
+            size_t count = rxBufferRing.read(USBMIDIpackets, maxPackets);
 
-            if (returnValue)
-            {
 #ifdef FW_APP
 #ifdef LED_INDICATORS
+            if (count)
                 Board::detail::io::indicateMIDItraffic(MIDI::interface_t::usb, Board::detail::midiTrafficDirection_t::incoming);
 #endif
 #endif
-            }
 
-            return returnValue;
+            return count;
         }
 
         bool writeMIDI(MIDI::USBMIDIpacket_t& USBMIDIpacket)
@@ -0,0 +1,289 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "DINMIDIencoder.h"
+
+#define NRPN_PARAM_MSB      99
+#define NRPN_PARAM_LSB      98
+#define RPN_PARAM_MSB       101
+#define RPN_PARAM_LSB       100
+#define NRPN_PARAM_UNKNOWN  0xFF
+#define STATUS_CC           0xB0
+#define STATUS_SYSEX_START  0xF0
+#define STATUS_SYSEX_END    0xF7
+#define STATUS_REALTIME_MIN 0xF8
+
+constexpr size_t DINMIDIencoder::MAX_OUTPUT_SIZE;
+
+///
+/// \brief Enables or disables running status and NRPN parameter select optimizations.
+/// When disabled, every message is sent in full, but the encoder still parses the stream
+/// so that local and loopback messages are never interleaved mid-message.
+/// @param [in] state   New optimization state (true/enabled, false/disabled).
+///
+void DINMIDIencoder::setOptimizationState(bool state)
+{
+    optimizationEnabled = state;
+
+    //force full messages to be sent after the change
+    lastStatus = 0;
+
+    for (int i = 0; i < 16; i++)
+    {
+        lastNRPNparam[i][0] = NRPN_PARAM_UNKNOWN;
+        lastNRPNparam[i][1] = NRPN_PARAM_UNKNOWN;
+    }
+}
+
+bool DINMIDIencoder::optimizationState()
+{
+    return optimizationEnabled;
+}
+
+///
+/// \brief Resets all parsing and wire state.
+/// Should be called when the underlying interface is (re)initialized since the
+/// receiving device can't be assumed to have any running status.
+///
+void DINMIDIencoder::reset()
+{
+    for (int i = 0; i < static_cast<uint8_t>(source_t::AMOUNT); i++)
+        parser[i] = {};
+
+    sysExSource = source_t::AMOUNT;
+
+    setOptimizationState(optimizationEnabled);
+}
+
+///
+/// \brief Processes single byte of MIDI data coming from specified source.
+/// @param [in]     source  Source of data. See source_t.
+/// @param [in]     data    Incoming MIDI byte.
+/// @param [in,out] output  Array in which bytes which should be sent are stored.
+///                         Must be at least MAX_OUTPUT_SIZE bytes long.
+/// \returns Number of bytes stored in output array.
+///
+size_t DINMIDIencoder::encode(source_t source, uint8_t data, uint8_t* output)
+{
+    auto& activeParser = parser[static_cast<uint8_t>(source)];
+
+    if (data >= STATUS_REALTIME_MIN)
+    {
+        //real-time messages can appear anywhere and don't affect running status
+        output[0] = data;
+        return 1;
+    }
+
+    if ((sysExSource != source_t::AMOUNT) && (sysExSource != source))
+    {
+        //other source is sending sysex - hold the output until it's done
+        uint8_t message[MAX_MESSAGE_SIZE];
+        size_t  size = parse(activeParser, data, message);
+
+        if (size > (HOLD_BUFFER_SIZE - activeParser.holdCount))
+        {
+            //message is dropped - force full messages to be sent after this
+            //since the state was already updated with the dropped message
+            setOptimizationState(optimizationEnabled);
+            return 0;
+        }
+
+        for (size_t i = 0; i < size; i++)
+            activeParser.hold[activeParser.holdCount++] = message[i];
+
+        return 0;
+    }
+
+    size_t size = parse(activeParser, data, output);
+
+    if (activeParser.sysExState)
+    {
+        sysExSource = source;
+    }
+    else if (sysExSource == source)
+    {
+        //sysex is done - send everything the other source had to hold in the meantime
+        auto  otherSource = source == source_t::local ? source_t::loopback : source_t::local;
+        auto& otherParser = parser[static_cast<uint8_t>(otherSource)];
+
+        for (size_t i = 0; i < otherParser.holdCount; i++)
+            output[size++] = otherParser.hold[i];
+
+        otherParser.holdCount = 0;
+
+        //other source could have started its own sysex while it was held
+        sysExSource = otherParser.sysExState ? otherSource : source_t::AMOUNT;
+    }
+
+    return size;
+}
+
+///
+/// \brief Parses single non real-time byte of MIDI data using specified parser.
+/// Channel voice messages are buffered until complete and then emitted at once.
+/// SysEx and system common bytes are passed through immediately.
+/// @param [in]     activeParser    Parser of the source from which the data is coming.
+/// @param [in]     data            Incoming MIDI byte.
+/// @param [in,out] output          Array in which bytes which should be sent are stored.
+///                                 Must be at least MAX_MESSAGE_SIZE bytes long.
+/// \returns Number of bytes stored in output array.
+///
+size_t DINMIDIencoder::parse(parser_t& activeParser, uint8_t data, uint8_t* output)
+{
+    if (data & 0x80)
+    {
+        activeParser.dataCount  = 0;
+        activeParser.sysExState = false;
+
+        if (data < STATUS_SYSEX_START)
+        {
+            //channel voice message - wait for the data
+            activeParser.status = data;
+            return 0;
+        }
+
+        //sysex and system common messages cancel running status
+        lastStatus = 0;
+
+        if (data == STATUS_SYSEX_START)
+        {
+            activeParser.status     = 0;
+            activeParser.sysExState = true;
+        }
+        else
+        {
+            activeParser.status = dataLength(data) ? data : 0;
+        }
+
+        output[0] = data;
+        return 1;
+    }
+
+    if (activeParser.sysExState || !activeParser.status)
+    {
+        //sysex data or data without known status - pass through
+        output[0] = data;
+        return 1;
+    }
+
+    if (activeParser.status >= STATUS_SYSEX_START)
+    {
+        //system common data - pass through
+        output[0] = data;
+
+        if (++activeParser.dataCount == dataLength(activeParser.status))
+            activeParser.status = 0;
+
+        return 1;
+    }
+
+    activeParser.data[activeParser.dataCount++] = data;
+
+    if (activeParser.dataCount != dataLength(activeParser.status))
+        return 0;
+
+    //message complete - keep the status for incoming running status
+    activeParser.dataCount = 0;
+
+    return emitMessage(activeParser, output);
+}
+
+///
+/// \brief Returns number of data bytes for specified status byte.
+///
+uint8_t DINMIDIencoder::dataLength(uint8_t status)
+{
+    switch (status & 0xF0)
+    {
+    case 0xC0:
+    case 0xD0:
+        return 1;
+
+    case 0xF0:
+    {
+        switch (status)
+        {
+        case 0xF1:
+        case 0xF3:
+            return 1;
+
+        case 0xF2:
+            return 2;
+
+        default:
+            return 0;
+        }
+    }
+
+    default:
+        return 2;
+    }
+}
+
+///
+/// \brief Writes complete channel voice message to output array.
+/// Status byte is omitted if it matches the last one sent on the wire, and the
+/// entire message is omitted if it's NRPN parameter select which doesn't change
+/// currently selected parameter on the channel.
+/// \returns Number of bytes stored in output array.
+///
+size_t DINMIDIencoder::emitMessage(parser_t& parser, uint8_t* output)
+{
+    size_t  size    = 0;
+    uint8_t channel = parser.status & 0x0F;
+
+    if (optimizationEnabled && ((parser.status & 0xF0) == STATUS_CC))
+    {
+        switch (parser.data[0])
+        {
+        case NRPN_PARAM_MSB:
+        case NRPN_PARAM_LSB:
+        {
+            uint8_t& lastParam = lastNRPNparam[channel][parser.data[0] == NRPN_PARAM_MSB ? 0 : 1];
+
+            if (lastParam == parser.data[1])
+                return 0;
+
+            lastParam = parser.data[1];
+        }
+        break;
+
+        case RPN_PARAM_MSB:
+        case RPN_PARAM_LSB:
+        {
+            //data entry now applies to rpn - nrpn needs to be selected again
+            lastNRPNparam[channel][0] = NRPN_PARAM_UNKNOWN;
+            lastNRPNparam[channel][1] = NRPN_PARAM_UNKNOWN;
+        }
+        break;
+
+        default:
+            break;
+        }
+    }
+
+    if (!optimizationEnabled || (parser.status != lastStatus))
+        output[size++] = parser.status;
+
+    lastStatus = parser.status;
+
+    for (int i = 0; i < dataLength(parser.status); i++)
+        output[size++] = parser.data[i];
+
+    return size;
+}
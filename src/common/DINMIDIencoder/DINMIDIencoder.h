@@ -0,0 +1,120 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+///
+/// \brief Encoder for outgoing DIN MIDI byte stream.
+/// Tracks the status byte last sent on the wire across all data sources
+/// (local MIDI messages and loopback/merge traffic) so that redundant status bytes
+/// can be omitted (running status), and drops NRPN parameter select messages
+/// (CC 99/98) when the selected parameter on a channel hasn't changed.
+/// While one source is sending SysEx, output of the other source (except
+/// real-time messages) is held and sent once the SysEx is done.
+///
+class DINMIDIencoder
+{
+    public:
+    ///
+    /// \brief List of all data sources which can write to DIN MIDI output.
+    /// Each source is parsed separately so that messages from different sources
+    /// are always emitted as complete messages.
+    ///
+    enum class source_t : uint8_t
+    {
+        local,       ///< Messages generated by the application.
+        loopback,    ///< Incoming DIN MIDI traffic passed to DIN MIDI output.
+        AMOUNT
+    };
+
+    ///
+    /// \brief Maximum amount of bytes which can be held for single source while
+    /// the other one is sending SysEx. Messages which don't fit are dropped.
+    ///
+    static constexpr size_t HOLD_BUFFER_SIZE = 16;
+
+    ///
+    /// \brief Maximum amount of bytes single call to encode() can produce.
+    /// Byte which ends SysEx is followed by the output held for the other source.
+    ///
+    static constexpr size_t MAX_OUTPUT_SIZE = 1 + HOLD_BUFFER_SIZE;
+
+    DINMIDIencoder()
+    {
+        reset();
+    }
+
+    void   setOptimizationState(bool state);
+    bool   optimizationState();
+    void   reset();
+    size_t encode(source_t source, uint8_t data, uint8_t* output);
+
+    private:
+    ///
+    /// \brief Holds parsing state for single data source.
+    ///
+    struct parser_t
+    {
+        uint8_t status                 = 0;
+        uint8_t data[2]                = {};
+        uint8_t dataCount              = 0;
+        bool    sysExState             = false;
+        uint8_t hold[HOLD_BUFFER_SIZE] = {};
+        uint8_t holdCount              = 0;
+    };
+
+    ///
+    /// \brief Maximum amount of bytes single message can produce.
+    ///
+    static constexpr size_t MAX_MESSAGE_SIZE = 3;
+
+    size_t  parse(parser_t& parser, uint8_t data, uint8_t* output);
+    uint8_t dataLength(uint8_t status);
+    size_t  emitMessage(parser_t& parser, uint8_t* output);
+
+    ///
+    /// \brief Flag indicating whether running status and NRPN optimizations are enabled.
+    ///
+    bool optimizationEnabled = false;
+
+    ///
+    /// \brief Parsing state for each data source.
+    ///
+    parser_t parser[static_cast<uint8_t>(source_t::AMOUNT)] = {};
+
+    ///
+    /// \brief Source whose SysEx is currently being sent on the wire.
+    /// Set to source_t::AMOUNT if there is none.
+    ///
+    source_t sysExSource = source_t::AMOUNT;
+
+    ///
+    /// \brief Last status byte sent on the wire.
+    /// Set to 0 when running status is cancelled (SysEx, system common messages).
+    ///
+    uint8_t lastStatus = 0;
+
+    ///
+    /// \brief Last NRPN parameter MSB (CC 99) and LSB (CC 98) sent on each MIDI channel.
+    /// 0xFF is used as an indicator that the value is unknown.
+    ///
+    uint8_t lastNRPNparam[16][2] = {};
+};
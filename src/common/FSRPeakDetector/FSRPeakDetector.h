@@ -0,0 +1,120 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+
+///
+/// \brief Strike detector for force sensitive resistors.
+/// Once the reading crosses onset threshold, the input should be sampled continuously
+/// until the detector reports the peak of the rising edge. Peak is reported either when
+/// the reading starts to fall or when the window expires, whichever comes first.
+/// While the input is pressed, current pressure is reported, and once it falls below
+/// release threshold, 0 is reported.
+/// Only one strike can be tracked at a time, which is sufficient since the input
+/// is sampled continuously until the peak is found.
+///
+class FSRPeakDetector
+{
+    public:
+    enum class result_t : uint8_t
+    {
+        none,        ///< Nothing to report.
+        sampling,    ///< Strike is in progress - same input should be sampled again.
+        report       ///< New value should be reported.
+    };
+
+    ///
+    /// @param [in] onsetThreshold      Reading above which the strike is detected.
+    /// @param [in] releaseThreshold    Reading below which pressed input is considered released.
+    /// @param [in] windowSize          Maximum amount of readings taken after the onset before the peak is reported.
+    ///                                 Must be at least 1.
+    ///
+    FSRPeakDetector(uint16_t onsetThreshold, uint16_t releaseThreshold, uint8_t windowSize)
+        : _onsetThreshold(onsetThreshold)
+        , _releaseThreshold(releaseThreshold)
+        , _windowSize(windowSize)
+    {}
+
+    ///
+    /// \brief Processes single reading of FSR input.
+    /// @param [in,out] pressed Pressed state of the input. Set once the peak is reported and cleared on release.
+    /// @param [in]     value   Raw reading.
+    /// @param [in,out] output  Value which should be reported: peak on strike, current pressure while pressed or 0 on release.
+    /// \returns See result_t.
+    ///
+    result_t process(bool& pressed, uint16_t value, uint16_t& output)
+    {
+        if (_samplesLeft)
+        {
+            if (value > _peak)
+                _peak = value;
+
+            //once the reading drops by more than 1/8 the peak has passed
+            bool falling = value < (_peak - (_peak >> 3));
+
+            if (!falling && --_samplesLeft)
+                return result_t::sampling;
+
+            _samplesLeft = 0;
+            pressed      = true;
+            output       = _peak;
+
+            return result_t::report;
+        }
+
+        if (!pressed)
+        {
+            if (value < _onsetThreshold)
+                return result_t::none;
+
+            _peak        = value;
+            _samplesLeft = _windowSize;
+
+            return result_t::sampling;
+        }
+
+        if (value < _releaseThreshold)
+        {
+            pressed = false;
+            output  = 0;
+        }
+        else
+        {
+            output = value;
+        }
+
+        return result_t::report;
+    }
+
+    ///
+    /// \brief Cancels the strike in progress, if any.
+    ///
+    void reset()
+    {
+        _samplesLeft = 0;
+    }
+
+    private:
+    const uint16_t _onsetThreshold;
+    const uint16_t _releaseThreshold;
+    const uint8_t  _windowSize;
+    uint16_t       _peak        = 0;
+    uint8_t        _samplesLeft = 0;
+};
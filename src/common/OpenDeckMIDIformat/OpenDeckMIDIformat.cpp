@@ -20,13 +20,24 @@ limitations under the License.
 
 #include "OpenDeckMIDIformat.h"
 #include "board/Board.h"
+#include "core/src/general/Timing.h"
+
+///
+/// \brief Time in milliseconds during which response to internal command is expected.
+///
+#define LINK_RESPONSE_TIMEOUT 50
+
+///
+/// \brief Value sent in command_t::linkCheck packets.
+///
+#define LINK_CHECK_PATTERN 0x55AA5A
 
 namespace OpenDeckMIDIformat
 {
     namespace
     {
         ///
-        /// \brief List of all bytes contained within OpenDeck packet.
+        /// \brief List of all bytes contained within single OpenDeck packet.
         ///
         enum class packet_t : uint8_t
         {
@@ -35,54 +46,279 @@ namespace OpenDeckMIDIformat
             data1,
             data2,
             data3,
-            dataXor
+            dataXor,
+            AMOUNT
+        };
+
+        ///
+        /// \brief List of header bytes contained within OpenDeck burst frame.
+        /// Header is followed by packet data and CRC8.
+        ///
+        enum class burst_t : uint8_t
+        {
+            packetType,
+            numberOfPackets,
+            AMOUNT
+        };
+
+        ///
+        /// \brief List of possible states of received frame.
+        ///
+        enum class frameState_t : uint8_t
+        {
+            incomplete,
+            valid,
+            invalid
+        };
+
+        constexpr size_t BURST_FRAME_MAX_SIZE = static_cast<size_t>(burst_t::AMOUNT) + (MAX_BURST_PACKETS * 4) + 1;
+
+        ///
+        /// \brief Buffer holding the frame currently being received.
+        ///
+        uint8_t readBytes[BURST_FRAME_MAX_SIZE] = {};
+        uint8_t incomingBytesCount              = 0;
+
+        ///
+        /// \brief Number of packets left to return from last received burst frame
+        /// and index of next one.
+        ///
+        uint8_t burstPacketsLeft = 0;
+        uint8_t burstPacketIndex = 0;
+
+        ///
+        /// \brief Buffer holding MIDI packets queued for sending in burst frame.
+        ///
+        uint8_t writeBytes[MAX_BURST_PACKETS * 4] = {};
+        uint8_t queuedPackets                      = 0;
+
+        ///
+        /// \brief List of baud rates which can be used on UART link, from highest to lowest.
+        /// All of them can be generated without error from 16MHz clock.
+        ///
+        const uint32_t linkBaudRates[] = {
+            1000000,
+            500000,
+            250000,
+            UART_BAUDRATE_MIDI_OD
         };
 
-        uint8_t incomingBytesCount = 0;
-        uint8_t readBytes[6]       = {};
-        uint8_t tempArray[5];
+        uint32_t currentBaudRate = UART_BAUDRATE_MIDI_OD;
+        uint32_t invalidFrames   = 0;
+
+        uint8_t crc8(uint8_t crc, uint8_t data)
+        {
+            crc ^= data;
+
+            for (int i = 0; i < 8; i++)
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+
+            return crc;
+        }
+
+        bool isFrameStart(uint8_t byte)
+        {
+            switch (static_cast<packetType_t>(byte))
+            {
+            case packetType_t::midi:
+            case packetType_t::internalCommand:
+            case packetType_t::midiBurst:
+                return true;
+
+            default:
+                return false;
+            }
+        }
+
+        ///
+        /// \brief Checks whether the bytes received so far make up a valid frame.
+        ///
+        frameState_t checkFrame()
+        {
+            if (!incomingBytesCount)
+                return frameState_t::incomplete;
+
+            if (readBytes[0] == static_cast<uint8_t>(packetType_t::midiBurst))
+            {
+                if (incomingBytesCount < static_cast<uint8_t>(burst_t::AMOUNT))
+                    return frameState_t::incomplete;
+
+                uint8_t numberOfPackets = readBytes[static_cast<uint8_t>(burst_t::numberOfPackets)];
+
+                if (!numberOfPackets || (numberOfPackets > MAX_BURST_PACKETS))
+                    return frameState_t::invalid;
+
+                size_t frameSize = static_cast<size_t>(burst_t::AMOUNT) + (numberOfPackets * 4) + 1;
+
+                if (incomingBytesCount < frameSize)
+                    return frameState_t::incomplete;
+
+                uint8_t crc = 0;
+
+                for (size_t i = static_cast<size_t>(burst_t::numberOfPackets); i < (frameSize - 1); i++)
+                    crc = crc8(crc, readBytes[i]);
+
+                return crc == readBytes[frameSize - 1] ? frameState_t::valid : frameState_t::invalid;
+            }
+
+            if (isFrameStart(readBytes[0]))
+            {
+                if (incomingBytesCount < static_cast<uint8_t>(packet_t::AMOUNT))
+                    return frameState_t::incomplete;
+
+                uint8_t dataXor = readBytes[static_cast<uint8_t>(packet_t::event)] ^
+                                  readBytes[static_cast<uint8_t>(packet_t::data1)] ^
+                                  readBytes[static_cast<uint8_t>(packet_t::data2)] ^
+                                  readBytes[static_cast<uint8_t>(packet_t::data3)];
+
+                return dataXor == readBytes[static_cast<uint8_t>(packet_t::dataXor)] ? frameState_t::valid : frameState_t::invalid;
+            }
+
+            return frameState_t::invalid;
+        }
+
+        ///
+        /// \brief Removes invalid frame start from incoming buffer.
+        /// All bytes up to the next possible frame start are removed as well so that
+        /// the remaining bytes can be checked again without waiting for new data.
+        ///
+        void resync()
+        {
+            uint8_t nextStart = 1;
+
+            while ((nextStart < incomingBytesCount) && !isFrameStart(readBytes[nextStart]))
+                nextStart++;
+
+            for (uint8_t i = nextStart; i < incomingBytesCount; i++)
+                readBytes[i - nextStart] = readBytes[i];
+
+            incomingBytesCount -= nextStart;
+        }
 
         ///
         /// \brief Appends read byte into internal storage.
-        /// If the buffer is full and valid packet still hasn't been
-        /// found, this function will shift all stored bytes by one
-        /// position to the left and write current byte to the
-        /// last position.
+        /// \returns True if the stored bytes make up a valid frame.
         ///
-        void appendIncoming(uint8_t byte)
+        bool appendIncoming(uint8_t byte)
         {
-            if (incomingBytesCount >= 6)
+            if (incomingBytesCount >= BURST_FRAME_MAX_SIZE)
+                resync();
+
+            readBytes[incomingBytesCount++] = byte;
+
+            while (true)
             {
-                //shift data
-                for (int i = 0; i < 5; i++)
-                    tempArray[i] = readBytes[i + 1];
+                switch (checkFrame())
+                {
+                case frameState_t::valid:
+                    return true;
+
+                case frameState_t::incomplete:
+                    return false;
+
+                default:
+                    invalidFrames++;
+                    resync();
+                    break;
+                }
+            }
+        }
+
+        ///
+        /// \brief Waits for specified internal command to be received.
+        /// All other packets received in the meantime are discarded.
+        /// @param [in]     channel         UART channel on MCU.
+        /// @param [in]     command         Internal command to wait for.
+        /// @param [in,out] USBMIDIpacket   Pointer to structure in which received command is stored.
+        /// \returns True if command has been received within LINK_RESPONSE_TIMEOUT, false otherwise.
+        ///
+        bool waitForCommand(uint8_t channel, command_t command, MIDI::USBMIDIpacket_t& USBMIDIpacket)
+        {
+            uint32_t     startTime = core::timing::currentRunTimeMs();
+            packetType_t packetType;
 
-                for (int i = 0; i < 5; i++)
-                    readBytes[i] = tempArray[i];
+            while ((core::timing::currentRunTimeMs() - startTime) < LINK_RESPONSE_TIMEOUT)
+            {
+                if (!read(channel, USBMIDIpacket, packetType))
+                    continue;
 
-                readBytes[5] = byte;
+                if ((packetType == packetType_t::internalCommand) && (USBMIDIpacket.Event == static_cast<uint8_t>(command)))
+                    return true;
             }
-            else
+
+            return false;
+        }
+
+        ///
+        /// \brief Sends command_t::linkCheck on current baud rate and verifies the response.
+        /// \returns True if the other side has responded with the same pattern, false otherwise.
+        ///
+        bool checkLink(uint8_t channel)
+        {
+            MIDI::USBMIDIpacket_t USBMIDIpacket;
+
+            buildCommand(USBMIDIpacket, command_t::linkCheck, LINK_CHECK_PATTERN);
+
+            if (!write(channel, USBMIDIpacket, packetType_t::internalCommand))
+                return false;
+
+            if (!waitForCommand(channel, command_t::linkCheck, USBMIDIpacket))
+                return false;
+
+            return commandValue(USBMIDIpacket) == LINK_CHECK_PATTERN;
+        }
+
+        ///
+        /// \brief Checks the link on each supported baud rate other than UART_BAUDRATE_MIDI_OD.
+        /// Used when the other side doesn't respond on UART_BAUDRATE_MIDI_OD since it could
+        /// still be using the baud rate negotiated before this side has been reset.
+        /// \returns True if the link has responded on one of the baud rates, false otherwise.
+        ///           In that case, UART_BAUDRATE_MIDI_OD is used again.
+        ///
+        bool findBaudRate(uint8_t channel)
+        {
+            for (size_t i = 0; i < (sizeof(linkBaudRates) / sizeof(linkBaudRates[0])); i++)
             {
-                readBytes[incomingBytesCount++] = byte;
+                if (linkBaudRates[i] == UART_BAUDRATE_MIDI_OD)
+                    break;
+
+                if (!setBaudRate(channel, linkBaudRates[i]))
+                    break;
+
+                if (checkLink(channel))
+                    return true;
             }
+
+            setBaudRate(channel, UART_BAUDRATE_MIDI_OD);
+            return false;
         }
 
         ///
-        /// \brief Clears the entire incoming buffer.
-        /// Should be called when valid packet has been processed.
+        /// \brief Returns next packet from last received burst frame.
         ///
-        void clearIncomingCount()
+        void nextBurstPacket(MIDI::USBMIDIpacket_t& USBMIDIpacket, packetType_t& packetType)
         {
-            incomingBytesCount = 0;
+            uint8_t offset = static_cast<uint8_t>(burst_t::AMOUNT) + (burstPacketIndex * 4);
 
-            for (int i = 0; i < 6; i++)
-                readBytes[i] = 0;
+            USBMIDIpacket.Event = readBytes[offset + 0];
+            USBMIDIpacket.Data1 = readBytes[offset + 1];
+            USBMIDIpacket.Data2 = readBytes[offset + 2];
+            USBMIDIpacket.Data3 = readBytes[offset + 3];
+            packetType          = packetType_t::midi;
+
+            burstPacketIndex++;
+
+            if (!--burstPacketsLeft)
+                incomingBytesCount = 0;
         }
     }    // namespace
 
     bool write(uint8_t channel, MIDI::USBMIDIpacket_t& USBMIDIpacket, packetType_t packetType)
     {
+        //make sure the order of packets is preserved
+        if (!flush(channel))
+            return false;
+
         if (!Board::UART::write(channel, static_cast<uint8_t>(packetType)))
             return false;
 
@@ -104,89 +340,231 @@ namespace OpenDeckMIDIformat
         return true;
     }
 
+    bool writeMIDI(uint8_t channel, MIDI::USBMIDIpacket_t& USBMIDIpacket)
+    {
+        uint8_t offset = queuedPackets * 4;
+
+        writeBytes[offset + 0] = USBMIDIpacket.Event;
+        writeBytes[offset + 1] = USBMIDIpacket.Data1;
+        writeBytes[offset + 2] = USBMIDIpacket.Data2;
+        writeBytes[offset + 3] = USBMIDIpacket.Data3;
+
+        if (++queuedPackets == MAX_BURST_PACKETS)
+            return flush(channel);
+
+        return true;
+    }
+
+    bool flush(uint8_t channel)
+    {
+        if (!queuedPackets)
+            return true;
+
+        uint8_t numberOfPackets = queuedPackets;
+        uint8_t crc             = crc8(0, numberOfPackets);
+
+        queuedPackets = 0;
+
+        if (!Board::UART::write(channel, static_cast<uint8_t>(packetType_t::midiBurst)))
+            return false;
+
+        if (!Board::UART::write(channel, numberOfPackets))
+            return false;
+
+        for (int i = 0; i < (numberOfPackets * 4); i++)
+        {
+            if (!Board::UART::write(channel, writeBytes[i]))
+                return false;
+
+            crc = crc8(crc, writeBytes[i]);
+        }
+
+        return Board::UART::write(channel, crc);
+    }
+
     bool read(uint8_t channel, MIDI::USBMIDIpacket_t& USBMIDIpacket, packetType_t& packetType)
     {
-        for (int i = 0; i < 6; i++)
+        if (burstPacketsLeft)
+        {
+            nextBurstPacket(USBMIDIpacket, packetType);
+            return true;
+        }
+
+        uint8_t value;
+        bool    frameReady = false;
+
+        while (!frameReady && Board::UART::read(channel, value))
+            frameReady = appendIncoming(value);
+
+        if (!frameReady)
+            return false;
+
+        if (readBytes[static_cast<uint8_t>(burst_t::packetType)] == static_cast<uint8_t>(packetType_t::midiBurst))
         {
-            uint8_t value;
+            burstPacketsLeft = readBytes[static_cast<uint8_t>(burst_t::numberOfPackets)];
+            burstPacketIndex = 0;
+
+            nextBurstPacket(USBMIDIpacket, packetType);
+            return true;
+        }
+
+        packetType          = static_cast<packetType_t>(readBytes[static_cast<uint8_t>(packet_t::packetType)]);
+        USBMIDIpacket.Event = readBytes[static_cast<uint8_t>(packet_t::event)];
+        USBMIDIpacket.Data1 = readBytes[static_cast<uint8_t>(packet_t::data1)];
+        USBMIDIpacket.Data2 = readBytes[static_cast<uint8_t>(packet_t::data2)];
+        USBMIDIpacket.Data3 = readBytes[static_cast<uint8_t>(packet_t::data3)];
+
+        incomingBytesCount = 0;
+
+        if (packetType == packetType_t::internalCommand)
+        {
+            switch (static_cast<command_t>(USBMIDIpacket.Event))
+            {
+            case command_t::btldrReboot:
+                Board::reboot(Board::rebootType_t::rebootBtldr);
+                break;
 
-            if (!Board::UART::read(channel, value))
+            case command_t::appReboot:
+                Board::reboot(Board::rebootType_t::rebootApp);
                 break;
-            else
-                appendIncoming(value);
 
-            if (incomingBytesCount == 6)
+            case command_t::baudRateChange:
+            case command_t::linkCheck:
+                //handled by the caller
                 break;
+
+            default:
+                return false;
+            }
         }
 
-        if (incomingBytesCount != 6)
+        return true;
+    }
+
+    bool baudRateSupported(uint32_t baudRate)
+    {
+        for (size_t i = 0; i < (sizeof(linkBaudRates) / sizeof(linkBaudRates[0])); i++)
+        {
+            if (linkBaudRates[i] == baudRate)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool setBaudRate(uint8_t channel, uint32_t baudRate)
+    {
+        if (!flush(channel))
             return false;
 
-        bool packetTypeValid = true;
+        while (!Board::UART::isTxEmpty(channel))
+            ;
 
-        if (readBytes[static_cast<uint8_t>(packet_t::packetType)] == static_cast<uint8_t>(packetType_t::midi))
-            packetType = static_cast<packetType_t>(readBytes[static_cast<uint8_t>(packet_t::packetType)]);
-        else if (readBytes[static_cast<uint8_t>(packet_t::packetType)] == static_cast<uint8_t>(packetType_t::internalCommand))
-            packetType = packetType_t::internalCommand;
-        else
-            packetTypeValid = false;
+        Board::UART::deInit(channel);
+
+        if (!Board::UART::init(channel, baudRate))
+            return false;
+
+        currentBaudRate    = baudRate;
+        incomingBytesCount = 0;
+        burstPacketsLeft   = 0;
+
+        return true;
+    }
+
+    uint32_t baudRate()
+    {
+        return currentBaudRate;
+    }
+
+    uint32_t negotiateBaudRate(uint8_t channel)
+    {
+        MIDI::USBMIDIpacket_t USBMIDIpacket;
+        bool                  linkResponded = false;
 
-        if (packetTypeValid)
+        for (size_t i = 0; i < (sizeof(linkBaudRates) / sizeof(linkBaudRates[0])); i++)
         {
-            //read the rest of the packet
-            for (int i = 0; i < 5; i++)
-            {
-                switch (i)
-                {
-                case 0:
-                    USBMIDIpacket.Event = readBytes[static_cast<uint8_t>(packet_t::event)];
-                    break;
+            if (linkBaudRates[i] == UART_BAUDRATE_MIDI_OD)
+                break;
 
-                case 1:
-                    USBMIDIpacket.Data1 = readBytes[static_cast<uint8_t>(packet_t::data1)];
-                    break;
+            buildCommand(USBMIDIpacket, command_t::baudRateChange, linkBaudRates[i]);
 
-                case 2:
-                    USBMIDIpacket.Data2 = readBytes[static_cast<uint8_t>(packet_t::data2)];
-                    break;
+            if (!write(channel, USBMIDIpacket, packetType_t::internalCommand))
+                break;
 
-                case 3:
-                    USBMIDIpacket.Data3 = readBytes[static_cast<uint8_t>(packet_t::data3)];
-                    break;
+            if (!waitForCommand(channel, command_t::baudRateChange, USBMIDIpacket))
+            {
+                //if the link hasn't responded at all, it could still be running on previously
+                //negotiated baud rate, or it doesn't support baud rate change
+                //otherwise, link could still be switching back after failed link check
+                if (!linkResponded)
+                {
+                    if (findBaudRate(channel))
+                        return currentBaudRate;
 
-                case 4:
-                    //xor byte - do nothing
                     break;
                 }
+
+                continue;
             }
 
-            if (readBytes[static_cast<uint8_t>(packet_t::dataXor)] == (USBMIDIpacket.Event ^ USBMIDIpacket.Data1 ^ USBMIDIpacket.Data2 ^ USBMIDIpacket.Data3))
-            {
-                clearIncomingCount();
+            linkResponded = true;
 
-                if (packetType == packetType_t::internalCommand)
-                {
-                    switch (static_cast<command_t>(USBMIDIpacket.Event))
-                    {
-                    case command_t::btldrReboot:
-                        Board::reboot(Board::rebootType_t::rebootBtldr);
-                        break;
-
-                    case command_t::appReboot:
-                        Board::reboot(Board::rebootType_t::rebootApp);
-                        break;
-
-                    default:
-                        return false;
-                    }
-                }
+            if (commandValue(USBMIDIpacket) != linkBaudRates[i])
+                continue;    //rejected
 
-                return true;
-            }
+            if (!setBaudRate(channel, linkBaudRates[i]))
+                break;
+
+            if (checkLink(channel))
+                return currentBaudRate;
+
+            //link switches back on its own once the check isn't received in time
+            setBaudRate(channel, UART_BAUDRATE_MIDI_OD);
+            core::timing::waitMs(LINK_CHECK_TIMEOUT);
         }
 
-        return false;
+        if (currentBaudRate != UART_BAUDRATE_MIDI_OD)
+            setBaudRate(channel, UART_BAUDRATE_MIDI_OD);
+
+        return currentBaudRate;
+    }
+
+    bool resetBaudRate(uint8_t channel)
+    {
+        if (currentBaudRate == UART_BAUDRATE_MIDI_OD)
+            return true;
+
+        MIDI::USBMIDIpacket_t USBMIDIpacket;
+
+        buildCommand(USBMIDIpacket, command_t::baudRateChange, UART_BAUDRATE_MIDI_OD);
+
+        if (!write(channel, USBMIDIpacket, packetType_t::internalCommand))
+            return false;
+
+        //response isn't important here - other side switches right after sending it
+        waitForCommand(channel, command_t::baudRateChange, USBMIDIpacket);
+
+        return setBaudRate(channel, UART_BAUDRATE_MIDI_OD);
+    }
+
+    void buildCommand(MIDI::USBMIDIpacket_t& USBMIDIpacket, command_t command, uint32_t value)
+    {
+        USBMIDIpacket.Event = static_cast<uint8_t>(command);
+        USBMIDIpacket.Data1 = (value >> 16) & 0xFF;
+        USBMIDIpacket.Data2 = (value >> 8) & 0xFF;
+        USBMIDIpacket.Data3 = value & 0xFF;
+    }
+
+    uint32_t commandValue(MIDI::USBMIDIpacket_t& USBMIDIpacket)
+    {
+        return (static_cast<uint32_t>(USBMIDIpacket.Data1) << 16) | (static_cast<uint32_t>(USBMIDIpacket.Data2) << 8) | USBMIDIpacket.Data3;
+    }
+
+    uint32_t errorCount()
+    {
+        return invalidFrames;
     }
 }    // namespace OpenDeckMIDIformat
 
-#endif
\ No newline at end of file
+#endif
@@ -27,8 +27,12 @@ namespace OpenDeckMIDIformat
     ///
     enum class command_t : uint8_t
     {
-        btldrReboot,    ///< Signal to USB link MCU to reboot to bootloader mode.
-        appReboot       ///< Signal to USB link MCU to reboot to application mode.
+        btldrReboot,       ///< Signal to USB link MCU to reboot to bootloader mode.
+        appReboot,         ///< Signal to USB link MCU to reboot to application mode.
+        baudRateChange,    ///< Request to change UART baud rate, stored in Data1-Data3.
+                           ///< Response contains the same baud rate if accepted, 0 otherwise.
+        linkCheck          ///< Used to verify the link after baud rate change.
+                           ///< Receiving side should respond with the same packet.
     };
 
     enum class packetType_t : uint8_t
@@ -37,8 +41,23 @@ namespace OpenDeckMIDIformat
                                    ///< Indicates start of MIDI data when OpenDeck MIDI format is used.
         internalCommand = 0xF2,    ///< Internal command used for target MCU <> USB link communication.
                                    ///< Indicates start of internal data when OpenDeck MIDI format is used.
+        midiBurst = 0xF3,          ///< Multiple MIDI packets in single frame.
+                                   ///< Frame consists of start byte, number of packets, packets and CRC8 of
+                                   ///< number of packets and packet data. When read, each packet from the
+                                   ///< frame is returned separately with packet type set to packetType_t::midi.
     };
 
+    ///
+    /// \brief Maximum number of MIDI packets sent in single packetType_t::midiBurst frame.
+    ///
+    constexpr uint8_t MAX_BURST_PACKETS = 8;
+
+    ///
+    /// \brief Time in milliseconds after which the side which has accepted new baud rate
+    /// switches back to UART_BAUDRATE_MIDI_OD if link check isn't received.
+    ///
+    constexpr uint32_t LINK_CHECK_TIMEOUT = 100;
+
     ///
     /// \brief Used to read data using custom OpenDeck format from UART interface.
     /// @param [in] channel         UART channel on MCU.
@@ -56,4 +75,82 @@ namespace OpenDeckMIDIformat
     /// \returns True on success, false otherwise.
     ///
     bool write(uint8_t channel, MIDI::USBMIDIpacket_t& USBMIDIpacket, packetType_t packetType);
+
+    ///
+    /// \brief Used to queue MIDI packet for sending in packetType_t::midiBurst frame.
+    /// Queued packets are sent once MAX_BURST_PACKETS packets are queued or when flush() is called.
+    /// Only single UART channel is supported for queueing.
+    /// @param [in] channel         UART channel on MCU.
+    /// @param [in] USBMIDIpacket   Pointer to structure holding MIDI data to write.
+    /// \returns True on success, false otherwise.
+    ///
+    bool writeMIDI(uint8_t channel, MIDI::USBMIDIpacket_t& USBMIDIpacket);
+
+    ///
+    /// \brief Sends all MIDI packets queued with writeMIDI() as single frame.
+    /// @param [in] channel UART channel on MCU.
+    /// \returns True on success or if there is nothing to send, false otherwise.
+    ///
+    bool flush(uint8_t channel);
+
+    ///
+    /// \brief Checks if the specified baud rate can be used on UART link.
+    /// @param [in] baudRate    Baud rate to check.
+    /// \returns True if baud rate is supported, false otherwise.
+    ///
+    bool baudRateSupported(uint32_t baudRate);
+
+    ///
+    /// \brief Changes the baud rate of UART link once all outgoing data has been sent.
+    /// Incoming data which hasn't been read yet is discarded.
+    /// @param [in] channel     UART channel on MCU.
+    /// @param [in] baudRate    New baud rate.
+    /// \returns True on success, false otherwise.
+    ///
+    bool setBaudRate(uint8_t channel, uint32_t baudRate);
+
+    ///
+    /// \brief Returns currently used baud rate of UART link.
+    ///
+    uint32_t baudRate();
+
+    ///
+    /// \brief Agrees on the highest baud rate supported by both sides of the UART link.
+    /// Each supported baud rate, starting from the highest one, is requested with
+    /// command_t::baudRateChange and verified with command_t::linkCheck once both sides
+    /// switch to it. If none of the baud rates work, UART_BAUDRATE_MIDI_OD is used.
+    /// If the other side doesn't respond on UART_BAUDRATE_MIDI_OD, the link is checked on
+    /// each supported baud rate in case the other side still uses previously negotiated one.
+    /// Blocking - should be called once both sides have initialized the link.
+    /// @param [in] channel UART channel on MCU.
+    /// \returns Negotiated baud rate.
+    ///
+    uint32_t negotiateBaudRate(uint8_t channel);
+
+    ///
+    /// \brief Switches both sides of UART link back to UART_BAUDRATE_MIDI_OD.
+    /// @param [in] channel UART channel on MCU.
+    /// \returns True on success, false otherwise.
+    ///
+    bool resetBaudRate(uint8_t channel);
+
+    ///
+    /// \brief Used to build internal command packet with 24-bit value stored in Data1-Data3.
+    /// @param [in,out] USBMIDIpacket   Pointer to structure in which command is stored.
+    /// @param [in]     command         Internal command.
+    /// @param [in]     value           Value to store in the packet.
+    ///
+    void buildCommand(MIDI::USBMIDIpacket_t& USBMIDIpacket, command_t command, uint32_t value);
+
+    ///
+    /// \brief Returns 24-bit value stored in Data1-Data3 of internal command packet.
+    ///
+    uint32_t commandValue(MIDI::USBMIDIpacket_t& USBMIDIpacket);
+
+    ///
+    /// \brief Returns total number of invalid frames received on UART link.
+    /// Includes frames with wrong checksum, invalid header and bytes received
+    /// outside of frames.
+    ///
+    uint32_t errorCount();
 }    // namespace OpenDeckMIDIformat
\ No newline at end of file
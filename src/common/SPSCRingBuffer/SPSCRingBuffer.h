@@ -0,0 +1,221 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+///
+/// \brief Helper used to select index type of SPSCRingBuffer.
+/// Single byte index is used for small buffers since only single byte access is atomic on AVR.
+/// @{
+
+template<bool small>
+struct SPSCRingBufferIndex
+{
+    using type = size_t;
+};
+
+template<>
+struct SPSCRingBufferIndex<true>
+{
+    using type = uint8_t;
+};
+
+/// @}
+
+///
+/// \brief Lock-free single-producer/single-consumer ring buffer.
+/// Intended for queues between interrupt and main context: one side only
+/// calls insert/write, the other only remove/read, and no interrupt disabling
+/// is needed. Producer publishes new data by storing head index with release
+/// semantics, consumer frees space by storing tail index with release semantics,
+/// and each side loads the index owned by the other side with acquire semantics.
+/// Indexes run freely and are wrapped with mask, which is why the size must be
+/// power of two.
+/// @tparam T       Type of data stored in buffer.
+/// @tparam size    Buffer capacity. Must be power of two.
+///
+template<typename T, size_t size>
+class SPSCRingBuffer
+{
+    static_assert(size && !(size & (size - 1)), "Buffer size must be power of two.");
+
+#ifdef __AVR__
+    //only single byte access is atomic on avr
+    static_assert(size <= 128, "Buffer size on AVR can't be larger than 128.");
+#endif
+
+    public:
+    SPSCRingBuffer() = default;
+
+    ///
+    /// \brief Stores single element in the buffer. Producer side only.
+    /// \returns True on success, false if the buffer is full.
+    ///
+    bool insert(T data)
+    {
+        index_t head = _head;
+
+        if (static_cast<index_t>(head - loadAcquire(_tail)) == size)
+            return false;
+
+        _buffer[head & mask] = data;
+        storeRelease(_head, head + 1);
+
+        return true;
+    }
+
+    ///
+    /// \brief Removes single element from the buffer. Consumer side only.
+    /// \returns True on success, false if the buffer is empty.
+    ///
+    bool remove(T& data)
+    {
+        index_t tail = _tail;
+
+        if (loadAcquire(_head) == tail)
+            return false;
+
+        data = _buffer[tail & mask];
+        storeRelease(_tail, tail + 1);
+
+        return true;
+    }
+
+    ///
+    /// \brief Stores up to specified amount of elements in the buffer. Producer side only.
+    /// All stored elements become visible to consumer at once.
+    /// @param [in] data    Pointer to elements which should be stored.
+    /// @param [in] amount  Amount of elements to store.
+    /// \returns Amount of elements actually stored.
+    ///
+    size_t write(const T* data, size_t amount)
+    {
+        index_t head  = _head;
+        size_t  space = size - static_cast<index_t>(head - loadAcquire(_tail));
+
+        if (amount > space)
+            amount = space;
+
+        for (size_t i = 0; i < amount; i++)
+            _buffer[(head + i) & mask] = data[i];
+
+        storeRelease(_head, static_cast<index_t>(head + amount));
+
+        return amount;
+    }
+
+    ///
+    /// \brief Removes up to specified amount of elements from the buffer. Consumer side only.
+    /// @param [in,out] data    Pointer to array in which removed elements are stored.
+    /// @param [in]     amount  Maximum amount of elements to remove.
+    /// \returns Amount of elements actually removed.
+    ///
+    size_t read(T* data, size_t amount)
+    {
+        index_t tail      = _tail;
+        size_t  available = static_cast<index_t>(loadAcquire(_head) - tail);
+
+        if (amount > available)
+            amount = available;
+
+        for (size_t i = 0; i < amount; i++)
+            data[i] = _buffer[(tail + i) & mask];
+
+        storeRelease(_tail, static_cast<index_t>(tail + amount));
+
+        return amount;
+    }
+
+    ///
+    /// \brief Returns amount of elements currently stored in the buffer.
+    /// Exact only when called from either producer or consumer side.
+    ///
+    size_t count() const
+    {
+        return static_cast<index_t>(loadAcquire(_head) - loadAcquire(_tail));
+    }
+
+    ///
+    /// \brief Returns amount of elements which can still be stored in the buffer.
+    ///
+    size_t freeSpace() const
+    {
+        return size - count();
+    }
+
+    bool isEmpty() const
+    {
+        return count() == 0;
+    }
+
+    bool isFull() const
+    {
+        return count() == size;
+    }
+
+    ///
+    /// \brief Discards all stored elements.
+    /// Must not be called while producer or consumer could access the buffer.
+    ///
+    void reset()
+    {
+        storeRelease(_head, 0);
+        storeRelease(_tail, 0);
+    }
+
+    private:
+    ///
+    /// \brief Index type. Must be loaded and stored in single instruction and able
+    /// to hold the value of size, so that full buffer can be distinguished from
+    /// the empty one.
+    ///
+    using index_t = typename SPSCRingBufferIndex<(size < 256)>::type;
+
+    static constexpr index_t mask = size - 1;
+
+    static index_t loadAcquire(const volatile index_t& index)
+    {
+#ifdef __AVR__
+        //single core, in-order execution - compiler barrier is enough
+        index_t value = index;
+        __asm__ __volatile__("" ::
+                                 : "memory");
+        return value;
+#else
+        return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#endif
+    }
+
+    static void storeRelease(volatile index_t& index, index_t value)
+    {
+#ifdef __AVR__
+        __asm__ __volatile__("" ::
+                                 : "memory");
+        index = value;
+#else
+        __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#endif
+    }
+
+    T                _buffer[size] = {};
+    volatile index_t _head         = 0;
+    volatile index_t _tail         = 0;
+};
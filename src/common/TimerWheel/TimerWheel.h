@@ -0,0 +1,190 @@
+/*
+
+Copyright 2015-2020 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+///
+/// \brief Helper used to select index type of TimerWheel.
+/// Two index values past the last timer are reserved as markers.
+/// @{
+
+template<bool small>
+struct TimerWheelIndex
+{
+    using type = uint16_t;
+};
+
+template<>
+struct TimerWheelIndex<true>
+{
+    using type = uint8_t;
+};
+
+/// @}
+
+///
+/// \brief Hashed timer wheel holding at most one pending timer per ID.
+/// Timers are kept in singly linked lists, one for each slot, and the slot is
+/// selected with the lowest bits of the expiry tick. Advancing the wheel visits
+/// only the slots for elapsed ticks, and returns immediately when no timer is
+/// pending, so idle cost doesn't depend on the amount of timers.
+/// Ticks run freely and wrap around: expiry tick must be less than 32768 ticks
+/// away from the tick passed to advance().
+/// @tparam size    Maximum amount of timers (IDs 0 to size-1).
+/// @tparam slots   Amount of slots in the wheel. Must be power of two.
+///
+template<size_t size, size_t slots>
+class TimerWheel
+{
+    static_assert(slots && !(slots & (slots - 1)), "Amount of slots must be power of two.");
+    static_assert(size < 65534, "Too many timers.");
+
+    public:
+    TimerWheel()
+    {
+        reset();
+    }
+
+    ///
+    /// \brief Starts the timer for specified ID. Pending timer for the same ID is restarted.
+    /// @param [in] id      Timer ID.
+    /// @param [in] expiry  Tick at which the timer expires.
+    ///
+    void start(size_t id, uint16_t expiry)
+    {
+        stop(id);
+
+        index_t& head = _head[expiry & mask];
+
+        _expiry[id] = expiry;
+        _next[id]   = head;
+        head        = id;
+
+        _count++;
+    }
+
+    ///
+    /// \brief Stops pending timer for specified ID. Nothing is done if the timer isn't pending.
+    ///
+    void stop(size_t id)
+    {
+        if (_next[id] == IDLE)
+            return;
+
+        index_t* link = &_head[_expiry[id] & mask];
+
+        while (*link != id)
+            link = &_next[*link];
+
+        *link     = _next[id];
+        _next[id] = IDLE;
+
+        _count--;
+    }
+
+    ///
+    /// \brief Checks whether the timer for specified ID is pending.
+    ///
+    bool isActive(size_t id) const
+    {
+        return _next[id] != IDLE;
+    }
+
+    ///
+    /// \brief Returns amount of pending timers.
+    ///
+    size_t count() const
+    {
+        return _count;
+    }
+
+    ///
+    /// \brief Stops all timers.
+    ///
+    void reset()
+    {
+        for (size_t i = 0; i < slots; i++)
+            _head[i] = END;
+
+        for (size_t i = 0; i < size; i++)
+            _next[i] = IDLE;
+
+        _count = 0;
+    }
+
+    ///
+    /// \brief Expires all timers which are due at specified tick.
+    /// Handler is called with the ID of each expired timer once the timer is removed.
+    /// Within the handler, only the timer for the ID passed to it can be started.
+    /// @param [in] tick    Current tick.
+    /// @param [in] handler Function called for each expired timer.
+    ///
+    template<typename T>
+    void advance(uint16_t tick, T&& handler)
+    {
+        uint16_t steps = tick - _tick;
+
+        _tick = tick;
+
+        if (!_count)
+            return;
+
+        //when more ticks than slots have elapsed, each slot needs to be checked only once
+        if (steps > slots)
+            steps = slots;
+
+        for (uint16_t i = 0; i < steps; i++)
+        {
+            index_t* link = &_head[(tick - i) & mask];
+
+            while (*link != END)
+            {
+                index_t id = *link;
+
+                if (static_cast<int16_t>(_expiry[id] - tick) > 0)
+                {
+                    //expires in one of the next rounds
+                    link = &_next[id];
+                    continue;
+                }
+
+                *link     = _next[id];
+                _next[id] = IDLE;
+                _count--;
+
+                handler(id);
+            }
+        }
+    }
+
+    private:
+    using index_t = typename TimerWheelIndex<(size < 254)>::type;
+
+    static constexpr size_t  mask = slots - 1;
+    static constexpr index_t END  = size;
+    static constexpr index_t IDLE = size + 1;
+
+    index_t  _head[slots]  = {};
+    index_t  _next[size]   = {};
+    uint16_t _expiry[size] = {};
+    uint16_t _tick         = 0;
+    size_t   _count        = 0;
+};
@@ -18,11 +18,91 @@ limitations under the License.
 
 #include "board/Board.h"
 #include "common/OpenDeckMIDIformat/OpenDeckMIDIformat.h"
+#include "core/src/general/Timing.h"
+
+///
+/// \brief Number of invalid frames received without any valid frame in between after which
+/// the link switches back to default baud rate.
+/// Used to recover in case the other side has been reset on its own.
+///
+#define LINK_ERROR_THRESHOLD 8
 
 namespace
 {
     MIDI::USBMIDIpacket_t            USBMIDIpacket;
     OpenDeckMIDIformat::packetType_t packetType;
+
+    ///
+    /// \brief Packets read from USB which are sent over the link in single frame.
+    ///
+    MIDI::USBMIDIpacket_t usbPackets[OpenDeckMIDIformat::MAX_BURST_PACKETS];
+
+    ///
+    /// \brief Flag indicating that the baud rate has been changed, but not verified yet.
+    ///
+    bool     linkCheckPending   = false;
+    uint32_t baudRateChangeTime = 0;
+
+    ///
+    /// \brief Number of link errors at the time last valid frame has been received.
+    ///
+    uint32_t lastErrorCount = 0;
+
+    void handleInternalCommand()
+    {
+        switch (static_cast<OpenDeckMIDIformat::command_t>(USBMIDIpacket.Event))
+        {
+        case OpenDeckMIDIformat::command_t::baudRateChange:
+        {
+            uint32_t baudRate = OpenDeckMIDIformat::commandValue(USBMIDIpacket);
+
+            if (!OpenDeckMIDIformat::baudRateSupported(baudRate))
+            {
+                OpenDeckMIDIformat::buildCommand(USBMIDIpacket, OpenDeckMIDIformat::command_t::baudRateChange, 0);
+                OpenDeckMIDIformat::write(UART_CHANNEL_USB_LINK, USBMIDIpacket, OpenDeckMIDIformat::packetType_t::internalCommand);
+                break;
+            }
+
+            //confirm on current baud rate, then switch
+            OpenDeckMIDIformat::write(UART_CHANNEL_USB_LINK, USBMIDIpacket, OpenDeckMIDIformat::packetType_t::internalCommand);
+            OpenDeckMIDIformat::setBaudRate(UART_CHANNEL_USB_LINK, baudRate);
+
+            //there is nothing to verify when switching back to default baud rate
+            linkCheckPending   = baudRate != UART_BAUDRATE_MIDI_OD;
+            baudRateChangeTime = core::timing::currentRunTimeMs();
+            lastErrorCount     = OpenDeckMIDIformat::errorCount();
+        }
+        break;
+
+        case OpenDeckMIDIformat::command_t::linkCheck:
+        {
+            OpenDeckMIDIformat::write(UART_CHANNEL_USB_LINK, USBMIDIpacket, OpenDeckMIDIformat::packetType_t::internalCommand);
+            linkCheckPending = false;
+        }
+        break;
+
+        default:
+            break;
+        }
+    }
+
+    void checkLink()
+    {
+        if (OpenDeckMIDIformat::baudRate() == UART_BAUDRATE_MIDI_OD)
+            return;
+
+        bool fallback = (OpenDeckMIDIformat::errorCount() - lastErrorCount) >= LINK_ERROR_THRESHOLD;
+
+        if (linkCheckPending && ((core::timing::currentRunTimeMs() - baudRateChangeTime) > OpenDeckMIDIformat::LINK_CHECK_TIMEOUT))
+            fallback = true;
+
+        if (fallback)
+        {
+            OpenDeckMIDIformat::setBaudRate(UART_CHANNEL_USB_LINK, UART_BAUDRATE_MIDI_OD);
+            linkCheckPending = false;
+            lastErrorCount   = OpenDeckMIDIformat::errorCount();
+        }
+    }
 }    // namespace
 
 int main(void)
@@ -31,13 +111,24 @@ int main(void)
 
     while (1)
     {
-        if (Board::USB::readMIDI(USBMIDIpacket))
-            OpenDeckMIDIformat::write(UART_CHANNEL_USB_LINK, USBMIDIpacket, OpenDeckMIDIformat::packetType_t::midi);
+        //send all packets received from usb in one frame
+        size_t usbPacketCount = Board::USB::readMIDI(usbPackets, OpenDeckMIDIformat::MAX_BURST_PACKETS);
+
+        for (size_t i = 0; i < usbPacketCount; i++)
+            OpenDeckMIDIformat::writeMIDI(UART_CHANNEL_USB_LINK, usbPackets[i]);
+
+        OpenDeckMIDIformat::flush(UART_CHANNEL_USB_LINK);
 
         if (OpenDeckMIDIformat::read(UART_CHANNEL_USB_LINK, USBMIDIpacket, packetType))
         {
+            lastErrorCount = OpenDeckMIDIformat::errorCount();
+
             if (packetType != OpenDeckMIDIformat::packetType_t::internalCommand)
                 Board::USB::writeMIDI(USBMIDIpacket);
+            else
+                handleInternalCommand();
         }
+
+        checkLink();
     }
-}
\ No newline at end of file
+}
@@ -105,6 +105,46 @@ TEST_CASE(ReadInitialValues)
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
             TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::midiChannel, i));
 
+        //debounce time section
+        //all values should be set to default debounce time
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(BUTTONS_DEFAULT_DEBOUNCE_TIME, database.read(Database::Section::button_t::debounceTime, i));
+
+        //debounce mode section
+        //all values should be set to 0 (stable mode)
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::debounceMode, i));
+
+        //long press section
+        //all values should be set to 0 (disabled)
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::longPress, i));
+
+        //long press midi id section
+        //all values should be set to 0
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::longPressMIDIid, i));
+
+        //double tap section
+        //all values should be set to 0 (disabled)
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::doubleTap, i));
+
+        //double tap midi id section
+        //all values should be set to 0
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::doubleTapMIDIid, i));
+
+        //repeat section
+        //all values should be set to 0 (disabled)
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::repeat, i));
+
+        //global parameters section
+        TEST_ASSERT_EQUAL_UINT32(BUTTONS_DEFAULT_LONG_PRESS_TIME, database.read(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::longPressTime)));
+        TEST_ASSERT_EQUAL_UINT32(BUTTONS_DEFAULT_DOUBLE_TAP_TIME, database.read(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::doubleTapTime)));
+        TEST_ASSERT_EQUAL_UINT32(BUTTONS_DEFAULT_REPEAT_TIME, database.read(Database::Section::button_t::global, static_cast<size_t>(IO::Buttons::setting_t::repeatTime)));
+
         //encoders block
         //enable section
         //all values should be set to 0
@@ -172,6 +212,31 @@ TEST_CASE(ReadInitialValues)
         for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
             TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::midiChannel, i));
 
+        //noise threshold section
+        //all values should be set to 0
+        for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::noiseThreshold, i));
+
+        //aftertouch type section
+        //all values should be set to 0 (aftertouch disabled)
+        for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::aftertouchType, i));
+
+        //aftertouch threshold section
+        //all values should be set to 2
+        for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+            TEST_ASSERT_EQUAL_UINT32(2, database.read(Database::Section::analog_t::aftertouchThreshold, i));
+
+        //global section
+        //all values should be set to 20
+        for (int i = 0; i < static_cast<uint8_t>(IO::Analog::setting_t::AMOUNT); i++)
+            TEST_ASSERT_EQUAL_UINT32(20, database.read(Database::Section::analog_t::global, i));
+
+        //response curve section
+        //all values should be set to 0 (linear)
+        for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::curve, i));
+
         //LED block
         //global section
         //all values should be set to 0
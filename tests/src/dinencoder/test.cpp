@@ -0,0 +1,185 @@
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include "common/DINMIDIencoder/DINMIDIencoder.h"
+#include <vector>
+
+namespace
+{
+    DINMIDIencoder       encoder;
+    std::vector<uint8_t> wire;
+
+    void send(DINMIDIencoder::source_t source, std::vector<uint8_t> data)
+    {
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            uint8_t output[DINMIDIencoder::MAX_OUTPUT_SIZE];
+            size_t  size = encoder.encode(source, data[i], output);
+
+            for (size_t j = 0; j < size; j++)
+                wire.push_back(output[j]);
+        }
+    }
+
+    void sendLocal(std::vector<uint8_t> data)
+    {
+        send(DINMIDIencoder::source_t::local, data);
+    }
+
+    void sendLoopback(std::vector<uint8_t> data)
+    {
+        send(DINMIDIencoder::source_t::loopback, data);
+    }
+
+    void reset(bool optimization)
+    {
+        encoder.setOptimizationState(optimization);
+        encoder.reset();
+        wire.clear();
+    }
+}    // namespace
+
+TEST_CASE(Passthrough)
+{
+    reset(false);
+
+    sendLocal({ 0x90, 0x10, 0x7F, 0x90, 0x10, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0x90, 0x10, 0x7F, 0x90, 0x10, 0x00 }));
+
+    wire.clear();
+
+    //repeated nrpn parameter select should be kept
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x02, 0xB0, 6, 0x10 });
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x02, 0xB0, 6, 0x11 });
+    TEST_ASSERT_EQUAL_UINT32(18, wire.size());
+}
+
+TEST_CASE(RunningStatus)
+{
+    reset(true);
+
+    sendLocal({ 0x90, 0x10, 0x7F, 0x90, 0x11, 0x7F, 0x80, 0x10, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0x90, 0x10, 0x7F, 0x11, 0x7F, 0x80, 0x10, 0x00 }));
+
+    wire.clear();
+
+    //incoming stream already using running status should be handled as well
+    sendLocal({ 0x80, 0x11, 0x00, 0x12, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0x11, 0x00, 0x12, 0x00 }));
+
+    wire.clear();
+
+    //sysex cancels running status
+    sendLocal({ 0xF0, 0x7E, 0x7F, 0xF7, 0x80, 0x13, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xF0, 0x7E, 0x7F, 0xF7, 0x80, 0x13, 0x00 }));
+
+    wire.clear();
+
+    //real-time messages don't affect running status
+    sendLocal({ 0x80, 0x14, 0xF8, 0x00, 0x80, 0x15, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xF8, 0x14, 0x00, 0x15, 0x00 }));
+
+    wire.clear();
+
+    //program change has single data byte
+    sendLocal({ 0xC1, 0x05, 0xC1, 0x06 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xC1, 0x05, 0x06 }));
+}
+
+TEST_CASE(Loopback)
+{
+    reset(true);
+
+    //loopback message changes the status on the wire - local message needs full status again
+    sendLocal({ 0x90, 0x10, 0x7F });
+    sendLoopback({ 0x91, 0x20, 0x7F });
+    sendLocal({ 0x90, 0x11, 0x7F });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0x90, 0x10, 0x7F, 0x91, 0x20, 0x7F, 0x90, 0x11, 0x7F }));
+
+    wire.clear();
+
+    //partial messages from different sources must not be interleaved
+    sendLoopback({ 0x92, 0x30 });
+    sendLocal({ 0x90, 0x12, 0x7F });
+    sendLoopback({ 0x7F });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0x12, 0x7F, 0x92, 0x30, 0x7F }));
+}
+
+TEST_CASE(SysExHold)
+{
+    reset(true);
+
+    //local message sent during loopback sysex should be held until the sysex is done
+    sendLoopback({ 0xF0, 0x01, 0x02 });
+    sendLocal({ 0x90, 0x10, 0x7F });
+    sendLoopback({ 0x03, 0xF7 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xF0, 0x01, 0x02, 0x03, 0xF7, 0x90, 0x10, 0x7F }));
+
+    wire.clear();
+
+    //same for loopback messages during local sysex, with the exception of real-time messages
+    sendLocal({ 0xF0, 0x01 });
+    sendLoopback({ 0x91, 0x20, 0x7F, 0xF8, 0x91, 0x21, 0x7F });
+    sendLocal({ 0x02, 0xF7 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xF0, 0x01, 0xF8, 0x02, 0xF7, 0x91, 0x20, 0x7F, 0x21, 0x7F }));
+
+    wire.clear();
+
+    //held sysex should be sent once the current one is done, and the other source held in turn
+    sendLocal({ 0xF0, 0x01 });
+    sendLoopback({ 0xF0, 0x02 });
+    sendLocal({ 0xF7, 0x90, 0x11, 0x7F });
+    sendLoopback({ 0x03, 0xF7 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xF0, 0x01, 0xF7, 0xF0, 0x02, 0x03, 0xF7, 0x90, 0x11, 0x7F }));
+
+    wire.clear();
+
+    //output which doesn't fit in hold buffer is dropped
+    reset(false);
+
+    sendLoopback({ 0xF0, 0x01 });
+
+    for (size_t i = 0; i <= DINMIDIencoder::HOLD_BUFFER_SIZE / 3; i++)
+        sendLocal({ 0x90, static_cast<uint8_t>(i), 0x7F });
+
+    sendLoopback({ 0xF7 });
+    TEST_ASSERT_EQUAL_UINT32(3 + (DINMIDIencoder::HOLD_BUFFER_SIZE / 3) * 3, wire.size());
+}
+
+TEST_CASE(NRPN)
+{
+    reset(true);
+
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x02, 0xB0, 6, 0x10, 0xB0, 38, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xB0, 99, 0x01, 98, 0x02, 6, 0x10, 38, 0x00 }));
+
+    wire.clear();
+
+    //same parameter - only the value should be sent
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x02, 0xB0, 6, 0x11, 0xB0, 38, 0x00 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 6, 0x11, 38, 0x00 }));
+
+    wire.clear();
+
+    //different channel uses its own parameter
+    sendLocal({ 0xB1, 99, 0x01, 0xB1, 98, 0x02, 0xB1, 6, 0x11 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xB1, 99, 0x01, 98, 0x02, 6, 0x11 }));
+
+    wire.clear();
+
+    //only lsb changed
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x03, 0xB0, 6, 0x12 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xB0, 98, 0x03, 6, 0x12 }));
+
+    wire.clear();
+
+    //rpn selection invalidates nrpn parameter
+    sendLocal({ 0xB0, 101, 0x00, 0xB0, 100, 0x00, 0xB0, 99, 0x01, 0xB0, 98, 0x03 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 101, 0x00, 100, 0x00, 99, 0x01, 98, 0x03 }));
+
+    wire.clear();
+
+    //after reset, everything needs to be sent again
+    encoder.reset();
+    sendLocal({ 0xB0, 99, 0x01, 0xB0, 98, 0x03, 0xB0, 6, 0x12 });
+    TEST_ASSERT(wire == std::vector<uint8_t>({ 0xB0, 99, 0x01, 98, 0x03, 6, 0x12 }));
+}
@@ -0,0 +1,86 @@
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include "io/analog/Curve.h"
+#include <stdlib.h>
+
+namespace
+{
+    const uint16_t maxValue[2] = { 127, 16383 };
+
+    IO::AnalogCurve::curve_t curve(uint8_t index)
+    {
+        return static_cast<IO::AnalogCurve::curve_t>(index);
+    }
+}    // namespace
+
+TEST_CASE(Endpoints)
+{
+    for (uint8_t i = 0; i < static_cast<uint8_t>(IO::AnalogCurve::curve_t::AMOUNT); i++)
+    {
+        for (int resolution = 0; resolution < 2; resolution++)
+        {
+            TEST_ASSERT_EQUAL_UINT32(0, IO::AnalogCurve::apply(curve(i), 0, resolution));
+            TEST_ASSERT_EQUAL_UINT32(maxValue[resolution], IO::AnalogCurve::apply(curve(i), maxValue[resolution], resolution));
+        }
+    }
+}
+
+TEST_CASE(Monotonicity)
+{
+    for (uint8_t i = 0; i < static_cast<uint8_t>(IO::AnalogCurve::curve_t::AMOUNT); i++)
+    {
+        for (int resolution = 0; resolution < 2; resolution++)
+        {
+            uint16_t previous = 0;
+
+            for (uint32_t value = 0; value <= maxValue[resolution]; value++)
+            {
+                uint16_t output = IO::AnalogCurve::apply(curve(i), value, resolution);
+
+                TEST_ASSERT(output >= previous);
+                TEST_ASSERT(output <= maxValue[resolution]);
+                previous = output;
+            }
+        }
+    }
+}
+
+TEST_CASE(Shape)
+{
+    for (int resolution = 0; resolution < 2; resolution++)
+    {
+        uint16_t quarter      = maxValue[resolution] / 4;
+        uint16_t threeQuarter = maxValue[resolution] - quarter;
+
+        //linear curve shouldn't change anything
+        for (uint32_t value = 0; value <= maxValue[resolution]; value++)
+            TEST_ASSERT_EQUAL_UINT32(value, IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::linear, value, resolution));
+
+        //logarithmic curve rises fast at the start
+        TEST_ASSERT(IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::logarithmic, quarter, resolution) > maxValue[resolution] / 2);
+
+        //exponential curve rises slowly at the start
+        TEST_ASSERT(IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::exponential, threeQuarter, resolution) < maxValue[resolution] / 2);
+
+        //s-curve is flat on both ends and symmetric around the middle
+        TEST_ASSERT(IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::sCurve, quarter, resolution) < quarter);
+        TEST_ASSERT(IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::sCurve, threeQuarter, resolution) > threeQuarter);
+
+        uint16_t low  = IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::sCurve, quarter, resolution);
+        uint16_t high = IO::AnalogCurve::apply(IO::AnalogCurve::curve_t::sCurve, threeQuarter, resolution);
+
+        TEST_ASSERT(abs((low + high) - maxValue[resolution]) <= 1);
+    }
+}
+
+TEST_CASE(OutOfRange)
+{
+    //values above the range should be treated as maximum
+    for (uint8_t i = 0; i < static_cast<uint8_t>(IO::AnalogCurve::curve_t::AMOUNT); i++)
+    {
+        if (curve(i) == IO::AnalogCurve::curve_t::linear)
+            continue;
+
+        TEST_ASSERT_EQUAL_UINT32(127, IO::AnalogCurve::apply(curve(i), 1000, false));
+    }
+}
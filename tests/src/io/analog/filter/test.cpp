@@ -0,0 +1,465 @@
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include "io/analog/Analog.h"
+#include "io/analog/Filter.h"
+#include "core/src/general/Timing.h"
+#include <vector>
+
+#ifdef ANALOG_SUPPORTED
+
+namespace
+{
+#ifdef ADC_12_BIT
+#define ADC_RESOLUTION       IO::Analog::Filter::adcType_t::adc12bit
+#define ADC_MAX_VALUE        4095
+#define ADC_MAX_VALUE_14_BIT (4095 * 4)
+#define FSR_MIN_VALUE  160
+#define FSR_MAX_VALUE  1360
+#define AFTERTOUCH_MAX_VALUE 2400
+#define ADC_NOISE      8
+#else
+#define ADC_RESOLUTION       IO::Analog::Filter::adcType_t::adc10bit
+#define ADC_MAX_VALUE        1023
+#define ADC_MAX_VALUE_14_BIT (1023 * 16)
+#define FSR_MIN_VALUE  40
+#define FSR_MAX_VALUE  340
+#define AFTERTOUCH_MAX_VALUE 600
+#define ADC_NOISE      2
+#endif
+
+//time after which fast filter is disabled in filter
+#define SLOW_FILTER_TIME 1000
+
+    ///
+    /// \brief Feeds the value to the filter specified amount of times and stores all filtered values.
+    ///
+    void feed(IO::AnalogFilter& filter, IO::Analog::type_t type, uint16_t value, size_t repetitions, std::vector<uint16_t>& output)
+    {
+        for (size_t i = 0; i < repetitions; i++)
+        {
+            uint16_t filteredValue;
+
+            if (filter.isFiltered(0, type, value, filteredValue))
+                output.push_back(filteredValue);
+        }
+    }
+
+    ///
+    /// \brief Generates reproducible ADC trace: linear movement between specified values
+    /// with uniform noise of specified amplitude and occasional single-sample spikes.
+    ///
+    class Trace
+    {
+        public:
+        Trace(uint16_t maxValue, uint16_t noise, size_t spikeInterval)
+            : _maxValue(maxValue)
+            , _noise(noise)
+            , _spikeInterval(spikeInterval)
+        {}
+
+        std::vector<uint16_t> generate(uint16_t from, uint16_t to, size_t samples)
+        {
+            std::vector<uint16_t> trace;
+
+            for (size_t i = 0; i < samples; i++)
+            {
+                int32_t value = from + ((static_cast<int32_t>(to) - from) * static_cast<int32_t>(i + 1)) / static_cast<int32_t>(samples);
+
+                if (_noise)
+                    value += static_cast<int32_t>(random() % (2 * _noise + 1)) - _noise;
+
+                if (_spikeInterval && !(++_sampleCounter % _spikeInterval))
+                    value = value > (_maxValue / 2) ? 0 : _maxValue;
+
+                trace.push_back(CONSTRAIN(value, 0, static_cast<int32_t>(_maxValue)));
+            }
+
+            return trace;
+        }
+
+        private:
+        uint32_t random()
+        {
+            //fixed seed linear congruential generator keeps the trace identical between runs
+            _seed = _seed * 1103515245 + 12345;
+            return (_seed >> 16) & 0x7FFF;
+        }
+
+        const uint16_t _maxValue;
+        const int32_t  _noise;
+        const size_t   _spikeInterval;
+        uint32_t       _seed          = 1;
+        size_t         _sampleCounter = 0;
+    };
+
+    ///
+    /// \brief Feeds the entire trace to the filter and stores all filtered values.
+    ///
+    void replay(IO::AnalogFilter& filter, IO::Analog::type_t type, const std::vector<uint16_t>& trace, std::vector<uint16_t>& output)
+    {
+        for (size_t i = 0; i < trace.size(); i++)
+            feed(filter, type, trace.at(i), 1, output);
+    }
+
+    ///
+    /// \brief Returns amount of samples from the trace the filter needs to output specified value.
+    ///
+    size_t samplesToReach(IO::AnalogFilter& filter, IO::Analog::type_t type, const std::vector<uint16_t>& trace, uint16_t target)
+    {
+        for (size_t i = 0; i < trace.size(); i++)
+        {
+            uint16_t filteredValue;
+
+            if (filter.isFiltered(0, type, trace.at(i), filteredValue) && (filteredValue == target))
+                return i + 1;
+        }
+
+        return trace.size() + 1;
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    //make sure the fast filter is inactive initially
+    core::timing::detail::rTime_ms = SLOW_FILTER_TIME;
+}
+
+TEST_CASE(FullRange)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+    std::vector<uint16_t> output;
+
+    //slowly sweep the entire adc range
+    for (uint32_t i = 0; i <= ADC_MAX_VALUE; i++)
+        feed(filter, IO::Analog::type_t::potentiometerControlChange, i, 3, output);
+
+    //stay on the maximum value long enough for the filter to settle
+    feed(filter, IO::Analog::type_t::potentiometerControlChange, ADC_MAX_VALUE, 30, output);
+
+    TEST_ASSERT(output.size() > 1);
+    TEST_ASSERT_EQUAL_UINT32(0, output.front());
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) > output.at(i - 1));
+
+    output.clear();
+
+    //go back to zero
+    for (int32_t i = ADC_MAX_VALUE; i >= 0; i--)
+        feed(filter, IO::Analog::type_t::potentiometerControlChange, i, 3, output);
+
+    feed(filter, IO::Analog::type_t::potentiometerControlChange, 0, 30, output);
+
+    TEST_ASSERT(output.size() > 1);
+    TEST_ASSERT_EQUAL_UINT32(0, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) < output.at(i - 1));
+
+    //same for 14-bit values
+    IO::AnalogFilter filter14bit(ADC_RESOLUTION, 1);
+    output.clear();
+
+    feed(filter14bit, IO::Analog::type_t::pitchBend, ADC_MAX_VALUE, 30, output);
+
+    TEST_ASSERT(output.size() > 1);
+
+    for (size_t i = 0; i < output.size(); i++)
+    {
+        TEST_ASSERT(output.at(i) <= MIDI_14_BIT_VALUE_MAX);
+
+        if (i)
+            TEST_ASSERT(output.at(i) > output.at(i - 1));
+    }
+}
+
+TEST_CASE(Median)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+    std::vector<uint16_t> output;
+
+    //initial value - wait until the filter settles
+    feed(filter, IO::Analog::type_t::potentiometerControlChange, ADC_MAX_VALUE / 2, 30, output);
+
+    TEST_ASSERT(output.size() > 0);
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX / 2, output.back());
+
+    //let the fast filter expire
+    core::timing::detail::rTime_ms += SLOW_FILTER_TIME;
+    output.clear();
+
+    //single outlier in each group of three samples should be ignored
+    for (int i = 0; i < 10; i++)
+    {
+        for (int j = 0; j < 3; j++)
+            feed(filter, IO::Analog::type_t::potentiometerControlChange, j == i % 3 ? ADC_MAX_VALUE : ADC_MAX_VALUE / 2, 1, output);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, output.size());
+
+    //outlier on the other side
+    for (int i = 0; i < 10; i++)
+    {
+        for (int j = 0; j < 3; j++)
+            feed(filter, IO::Analog::type_t::potentiometerControlChange, j == i % 3 ? 0 : ADC_MAX_VALUE / 2, 1, output);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, output.size());
+}
+
+TEST_CASE(FSR)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+    std::vector<uint16_t> output;
+
+    //fsr readings come from peak detector and should be passed immediately
+    //release should be reported as zero
+    feed(filter, IO::Analog::type_t::fsr, 0, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(1, output.size());
+    TEST_ASSERT_EQUAL_UINT32(0, output.back());
+
+    //pressed sensor with values below minimum should be reported with the lowest velocity
+    feed(filter, IO::Analog::type_t::fsr, FSR_MIN_VALUE / 2, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(2, output.size());
+    TEST_ASSERT_EQUAL_UINT32(1, output.back());
+
+    //readings following the strike are pressure of pressed sensor and should be flagged
+    //since the lowest pressure is 0
+    feed(filter, IO::Analog::type_t::fsr, FSR_MIN_VALUE / 2, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(3, output.size());
+    TEST_ASSERT_EQUAL_UINT32(ANALOG_FSR_PRESSURE_FLAG, output.back());
+
+    //pressure is mapped to aftertouch range
+    feed(filter, IO::Analog::type_t::fsr, FSR_MAX_VALUE, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(4, output.size());
+    TEST_ASSERT(output.back() & ANALOG_FSR_PRESSURE_FLAG);
+    TEST_ASSERT((output.back() & ~ANALOG_FSR_PRESSURE_FLAG) < MIDI_7_BIT_VALUE_MAX);
+
+    feed(filter, IO::Analog::type_t::fsr, AFTERTOUCH_MAX_VALUE, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(5, output.size());
+    TEST_ASSERT_EQUAL_UINT32(ANALOG_FSR_PRESSURE_FLAG | MIDI_7_BIT_VALUE_MAX, output.back());
+
+    //after release, values above maximum should be reported as maximum velocity
+    feed(filter, IO::Analog::type_t::fsr, 0, 1, output);
+    feed(filter, IO::Analog::type_t::fsr, ADC_MAX_VALUE, 1, output);
+
+    TEST_ASSERT_EQUAL_UINT32(7, output.size());
+    TEST_ASSERT_EQUAL_UINT32(0, output.at(5));
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, output.back());
+}
+
+TEST_CASE(Batch)
+{
+    IO::AnalogFilter filter(ADC_RESOLUTION, 1);
+    IO::AnalogFilter batchFilter(ADC_RESOLUTION, 1);
+
+    //batch filtering should produce the same results as filtering each channel separately
+    for (uint32_t i = 0; i <= ADC_MAX_VALUE; i++)
+    {
+        IO::Analog::Filter::sample_t samples[MAX_NUMBER_OF_ANALOG];
+        std::vector<uint16_t>        expected;
+
+        for (uint16_t j = 0; j < MAX_NUMBER_OF_ANALOG; j++)
+        {
+            //use different value and type for each channel
+            uint16_t value = (i + (j * 100)) % (ADC_MAX_VALUE + 1);
+            auto     type  = j % 2 ? IO::Analog::type_t::potentiometerControlChange : IO::Analog::type_t::pitchBend;
+
+            samples[j].index = j;
+            samples[j].type  = type;
+            samples[j].value = value;
+
+            uint16_t filteredValue;
+
+            if (filter.isFiltered(j, type, value, filteredValue))
+            {
+                expected.push_back(j);
+                expected.push_back(filteredValue);
+            }
+        }
+
+        size_t count = batchFilter.filterAll(samples, MAX_NUMBER_OF_ANALOG);
+
+        TEST_ASSERT_EQUAL_UINT32(expected.size() / 2, count);
+
+        for (size_t j = 0; j < count; j++)
+        {
+            TEST_ASSERT_EQUAL_UINT32(expected.at(j * 2), samples[j].index);
+            TEST_ASSERT_EQUAL_UINT32(expected.at(j * 2 + 1), samples[j].value);
+        }
+    }
+}
+
+TEST_CASE(NoiseThreshold)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+    std::vector<uint16_t> output;
+
+    //with threshold of 1 every change of 14-bit value is reported so that the filter settles exactly on the input
+    filter.setNoiseThreshold(0, 1);
+    feed(filter, IO::Analog::type_t::cc14bit, 8000, 60, output);
+    TEST_ASSERT(output.size() > 0);
+
+    //noisy channel - changes below the threshold should be ignored
+    filter.setNoiseThreshold(0, 20);
+    output.clear();
+    feed(filter, IO::Analog::type_t::cc14bit, 8015, 60, output);
+    TEST_ASSERT_EQUAL_UINT32(0, output.size());
+
+    //larger change should still be registered
+    feed(filter, IO::Analog::type_t::cc14bit, 8040, 60, output);
+    TEST_ASSERT(output.size() > 0);
+
+    //remaining change which was below the threshold should be registered once default thresholds are used again
+    filter.setNoiseThreshold(0, 0);
+    output.clear();
+    feed(filter, IO::Analog::type_t::cc14bit, 8040, 60, output);
+    TEST_ASSERT(output.size() > 0);
+}
+
+TEST_CASE(HighResolution)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+    std::vector<uint16_t> output;
+
+    //slowly sweep the entire range of oversampled input
+    for (uint32_t i = 0; i <= ADC_MAX_VALUE_14_BIT; i++)
+        feed(filter, IO::Analog::type_t::pitchBend, i, 3, output);
+
+    feed(filter, IO::Analog::type_t::pitchBend, ADC_MAX_VALUE_14_BIT, 60, output);
+
+    //output should have more distinct values than the ADC itself
+    TEST_ASSERT(output.size() > (ADC_MAX_VALUE + 1));
+    TEST_ASSERT_EQUAL_UINT32(0, output.front());
+    TEST_ASSERT_EQUAL_UINT32(MIDI_14_BIT_VALUE_MAX, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) > output.at(i - 1));
+
+    output.clear();
+
+    for (int32_t i = ADC_MAX_VALUE_14_BIT; i >= 0; i--)
+        feed(filter, IO::Analog::type_t::pitchBend, i, 3, output);
+
+    feed(filter, IO::Analog::type_t::pitchBend, 0, 60, output);
+
+    TEST_ASSERT(output.size() > (ADC_MAX_VALUE + 1));
+    TEST_ASSERT_EQUAL_UINT32(0, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) < output.at(i - 1));
+}
+
+TEST_CASE(AdaptiveRest)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1, IO::AnalogFilter::filterMode_t::adaptive);
+    Trace                 trace(ADC_MAX_VALUE, ADC_NOISE, 50);
+    std::vector<uint16_t> output;
+
+    //noisy pot at rest with occasional spikes - only the initial value should be sent
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(ADC_MAX_VALUE / 2, ADC_MAX_VALUE / 2, 100), output);
+
+    TEST_ASSERT_EQUAL_UINT32(1, output.size());
+    TEST_ASSERT(abs(static_cast<int>(output.at(0)) - (MIDI_7_BIT_VALUE_MAX / 2)) <= 1);
+
+    output.clear();
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(ADC_MAX_VALUE / 2, ADC_MAX_VALUE / 2, 5000), output);
+
+    TEST_ASSERT_EQUAL_UINT32(0, output.size());
+
+    //same for oversampled input
+    IO::AnalogFilter filter14bit(ADC_RESOLUTION, 1, IO::AnalogFilter::filterMode_t::adaptive);
+    Trace            trace14bit(ADC_MAX_VALUE_14_BIT, 2, 50);
+
+    replay(filter14bit, IO::Analog::type_t::pitchBend, trace14bit.generate(ADC_MAX_VALUE_14_BIT / 2, ADC_MAX_VALUE_14_BIT / 2, 200), output);
+
+    TEST_ASSERT_EQUAL_UINT32(1, output.size());
+    TEST_ASSERT(abs(static_cast<int>(output.at(0)) - (MIDI_14_BIT_VALUE_MAX / 2)) <= 2);
+
+    output.clear();
+    replay(filter14bit, IO::Analog::type_t::pitchBend, trace14bit.generate(ADC_MAX_VALUE_14_BIT / 2, ADC_MAX_VALUE_14_BIT / 2, 5000), output);
+
+    TEST_ASSERT_EQUAL_UINT32(0, output.size());
+}
+
+TEST_CASE(AdaptiveFastMovement)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1, IO::AnalogFilter::filterMode_t::adaptive);
+    IO::AnalogFilter      timedFilter(ADC_RESOLUTION, 1);
+    Trace                 trace(ADC_MAX_VALUE, ADC_NOISE, 0);
+    std::vector<uint16_t> output;
+
+    //settle both filters at zero
+    auto rest = trace.generate(0, 0, 100);
+
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, rest, output);
+    replay(timedFilter, IO::Analog::type_t::potentiometerControlChange, rest, output);
+
+    //let the fast filter expire
+    core::timing::detail::rTime_ms += SLOW_FILTER_TIME;
+    output.clear();
+
+    //quick flick of the pot over the entire range
+    auto movement = trace.generate(0, ADC_MAX_VALUE, 10);
+    auto hold     = trace.generate(ADC_MAX_VALUE, ADC_MAX_VALUE, 50);
+    movement.insert(movement.end(), hold.begin(), hold.end());
+
+    size_t samples      = samplesToReach(filter, IO::Analog::type_t::potentiometerControlChange, movement, MIDI_7_BIT_VALUE_MAX);
+    size_t timedSamples = samplesToReach(timedFilter, IO::Analog::type_t::potentiometerControlChange, movement, MIDI_7_BIT_VALUE_MAX);
+
+    //the end of the range should be reached shortly after the movement stops
+    TEST_ASSERT(samples <= 15);
+    TEST_ASSERT(samples < timedSamples);
+
+    //filtered values should follow the movement in single direction
+    IO::AnalogFilter sweepFilter(ADC_RESOLUTION, 1, IO::AnalogFilter::filterMode_t::adaptive);
+
+    replay(sweepFilter, IO::Analog::type_t::potentiometerControlChange, rest, output);
+    output.clear();
+    replay(sweepFilter, IO::Analog::type_t::potentiometerControlChange, movement, output);
+
+    TEST_ASSERT(output.size() > 1);
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) > output.at(i - 1));
+}
+
+TEST_CASE(AdaptiveSlowMovement)
+{
+    IO::AnalogFilter      filter(ADC_RESOLUTION, 1, IO::AnalogFilter::filterMode_t::adaptive);
+    Trace                 trace(ADC_MAX_VALUE, ADC_NOISE, 50);
+    std::vector<uint16_t> output;
+
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(0, 0, 100), output);
+    output.clear();
+
+    //slow noisy sweep with spikes - values should change in single direction without any jitter
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(0, ADC_MAX_VALUE, ADC_MAX_VALUE * 4), output);
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(ADC_MAX_VALUE, ADC_MAX_VALUE, 100), output);
+
+    TEST_ASSERT(output.size() > (MIDI_7_BIT_VALUE_MAX / 2));
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) > output.at(i - 1));
+
+    output.clear();
+
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(ADC_MAX_VALUE, 0, ADC_MAX_VALUE * 4), output);
+    replay(filter, IO::Analog::type_t::potentiometerControlChange, trace.generate(0, 0, 100), output);
+
+    TEST_ASSERT(output.size() > (MIDI_7_BIT_VALUE_MAX / 2));
+    TEST_ASSERT_EQUAL_UINT32(0, output.back());
+
+    for (size_t i = 1; i < output.size(); i++)
+        TEST_ASSERT(output.at(i) < output.at(i - 1));
+}
+
+#endif
@@ -0,0 +1,500 @@
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include "io/analog/Analog.h"
+#include "io/analog/Filter.h"
+#include "io/leds/LEDs.h"
+#include "io/common/CInfo.h"
+#include "database/Database.h"
+#include "midi/src/MIDI.h"
+#include "common/FSRPeakDetector/FSRPeakDetector.h"
+#include "core/src/general/Timing.h"
+#include "stubs/database/DB_ReadWrite.h"
+#include <vector>
+#include <math.h>
+
+#ifdef ANALOG_SUPPORTED
+
+namespace
+{
+#ifdef ADC_12_BIT
+#define ADC_RESOLUTION    IO::Analog::Filter::adcType_t::adc12bit
+#define ONSET_THRESHOLD   160
+#define RELEASE_THRESHOLD 80
+#define FSR_MIN_VALUE     160
+#define FSR_MAX_VALUE     1360
+#else
+#define ADC_RESOLUTION    IO::Analog::Filter::adcType_t::adc10bit
+#define ONSET_THRESHOLD   40
+#define RELEASE_THRESHOLD 20
+#define FSR_MIN_VALUE     40
+#define FSR_MAX_VALUE     340
+#endif
+
+#define PEAK_WINDOW 32
+
+    class DBhandlers : public Database::Handlers
+    {
+        public:
+        DBhandlers() {}
+
+        void presetChange(uint8_t preset) override
+        {
+            if (presetChangeHandler != nullptr)
+                presetChangeHandler(preset);
+        }
+
+        void factoryResetStart() override
+        {
+            if (factoryResetStartHandler != nullptr)
+                factoryResetStartHandler();
+        }
+
+        void factoryResetDone() override
+        {
+            if (factoryResetDoneHandler != nullptr)
+                factoryResetDoneHandler();
+        }
+
+        void initialized() override
+        {
+            if (initHandler != nullptr)
+                initHandler();
+        }
+
+        //actions which these handlers should take depend on objects making
+        //up the entire system to be initialized
+        //therefore in interface we are calling these function pointers which
+        // are set in application once we have all objects ready
+        void (*presetChangeHandler)(uint8_t preset) = nullptr;
+        void (*factoryResetStartHandler)()          = nullptr;
+        void (*factoryResetDoneHandler)()           = nullptr;
+        void (*initHandler)()                       = nullptr;
+    } dbHandlers;
+
+    class HWAMIDI : public MIDI::HWA
+    {
+        public:
+        HWAMIDI() = default;
+
+        bool init() override
+        {
+            return true;
+        }
+
+        bool dinRead(uint8_t& data) override
+        {
+            return false;
+        }
+
+        bool dinWrite(uint8_t data) override
+        {
+            return false;
+        }
+
+        bool usbRead(MIDI::USBMIDIpacket_t& USBMIDIpacket) override
+        {
+            return false;
+        }
+
+        bool usbWrite(MIDI::USBMIDIpacket_t& USBMIDIpacket) override
+        {
+            midiPacket.push_back(USBMIDIpacket);
+            return true;
+        }
+
+        std::vector<MIDI::USBMIDIpacket_t> midiPacket;
+    } hwaMIDI;
+
+    class HWALEDs : public IO::LEDs::HWA
+    {
+        public:
+        HWALEDs() {}
+
+        void setState(size_t index, bool state) override
+        {
+        }
+
+        size_t rgbSingleComponentIndex(size_t rgbIndex, IO::LEDs::rgbIndex_t rgbComponent) override
+        {
+            return 0;
+        }
+
+        size_t rgbIndex(size_t singleLEDindex) override
+        {
+            return 0;
+        }
+
+        void setFadeSpeed(size_t transitionSpeed) override
+        {
+        }
+    } hwaLEDs;
+
+    class HWAAnalog : public IO::Analog::HWA
+    {
+        public:
+        HWAAnalog() {}
+
+        void setScanState(size_t index, bool state) override
+        {
+        }
+
+        void setOversamplingState(size_t index, bool state) override
+        {
+        }
+
+        void setPeakDetectionState(size_t index, bool state) override
+        {
+        }
+
+        size_t newValues(uint8_t* indexes, uint16_t* values, size_t maxValues) override
+        {
+            for (size_t i = 0; i < maxValues; i++)
+            {
+                indexes[i] = i;
+                values[i]  = adcReturnValue;
+            }
+
+            return maxValues;
+        }
+
+        uint32_t adcReturnValue;
+    } hwaAnalog;
+
+    DBstorageMock dbStorageMock;
+    Database      database = Database(dbHandlers, dbStorageMock, true);
+    MIDI          midi(hwaMIDI);
+    ComponentInfo cInfo;
+
+    IO::LEDs leds(hwaLEDs, database);
+
+    class HWAU8X8 : public IO::U8X8::HWAI2C
+    {
+        public:
+        HWAU8X8() {}
+
+        bool init() override
+        {
+            return true;
+        }
+
+        bool deInit() override
+        {
+            return true;
+        }
+
+        bool write(uint8_t address, uint8_t* data, size_t size) override
+        {
+            return true;
+        }
+    } hwaU8X8;
+
+    class AnalogFilterStub : public IO::Analog::Filter
+    {
+        public:
+        AnalogFilterStub() {}
+
+        bool isFiltered(size_t index, IO::Analog::type_t type, uint16_t value, uint16_t& filteredValue) override
+        {
+            filteredValue = value;
+            return true;
+        }
+
+        void reset(size_t index) override
+        {
+        }
+
+        void setNoiseThreshold(size_t index, uint16_t threshold) override
+        {
+        }
+    } analogFilterStub;
+
+    IO::U8X8    u8x8(hwaU8X8);
+    IO::Display display(u8x8, database);
+
+    IO::Analog analog(hwaAnalog, analogFilterStub, database, midi, leds, display, cInfo);
+
+    ///
+    /// \brief Single value reported by the pipeline.
+    ///
+    struct report_t
+    {
+        size_t   sample;      ///< Index of reading after which the value has been reported.
+        uint16_t velocity;    ///< Value after filtering.
+    };
+
+    ///
+    /// \brief Returns raw reading of FSR at specified time for synthetic strike.
+    /// Force rises along sine curve to the peak, then falls along gaussian curve to the sustain level.
+    ///
+    uint16_t strikeCurve(double time, double peak, double riseTime, double sustain)
+    {
+        if (time < 0)
+            return 0;
+
+        if (time < riseTime)
+        {
+            double rise = sin(M_PI / 2 * time / riseTime);
+            return peak * rise * rise;
+        }
+
+        double fall = (time - riseTime) / riseTime;
+
+        return sustain + (peak - sustain) * exp(-fall * fall);
+    }
+
+    ///
+    /// \brief Feeds all readings through peak detector and filter, the same way board and application do.
+    ///
+    std::vector<report_t> pipeline(const std::vector<uint16_t>& readings)
+    {
+        FSRPeakDetector       detector(ONSET_THRESHOLD, RELEASE_THRESHOLD, PEAK_WINDOW);
+        IO::AnalogFilter      filter(ADC_RESOLUTION, 1);
+        std::vector<report_t> reports;
+        bool                  pressed = false;
+
+        for (size_t i = 0; i < readings.size(); i++)
+        {
+            uint16_t value;
+
+            if (detector.process(pressed, readings.at(i), value) != FSRPeakDetector::result_t::report)
+                continue;
+
+            uint16_t velocity;
+
+            if (filter.isFiltered(0, IO::Analog::type_t::fsr, value, velocity))
+                reports.push_back({ i, velocity });
+        }
+
+        return reports;
+    }
+
+    std::vector<uint16_t> sampleStrike(double peak, double riseTime, double sustain, double phase, size_t samples)
+    {
+        std::vector<uint16_t> readings;
+
+        for (size_t i = 0; i < samples; i++)
+            readings.push_back(strikeCurve(i + phase, peak, riseTime, sustain));
+
+        return readings;
+    }
+
+    uint16_t expectedVelocity(uint16_t value)
+    {
+        value = CONSTRAIN(value, FSR_MIN_VALUE, FSR_MAX_VALUE) - FSR_MIN_VALUE;
+        return (value * MIDI_7_BIT_VALUE_MAX) / (FSR_MAX_VALUE - FSR_MIN_VALUE);
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    //init checks - no point in running further tests if these conditions fail
+    TEST_ASSERT(database.init() == true);
+    TEST_ASSERT(database.factoryReset() == true);
+
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+        analog.debounceReset(i);
+
+    hwaMIDI.midiPacket.clear();
+    midi.init();
+    midi.enableUSBMIDI();
+}
+
+TEST_CASE(Strike)
+{
+    const uint16_t peak = (FSR_MIN_VALUE + FSR_MAX_VALUE) / 2;
+
+    auto reports = pipeline(sampleStrike(peak, 4, RELEASE_THRESHOLD * 2, 0, 50));
+
+    TEST_ASSERT(reports.size() > 0);
+
+    //first report is note on with the velocity of the peak, sent shortly after the peak
+    size_t peakSample = 4;
+
+    TEST_ASSERT(reports.front().sample > peakSample);
+    TEST_ASSERT(reports.front().sample <= peakSample + 2);
+    TEST_ASSERT(abs(reports.front().velocity - expectedVelocity(peak)) <= 1);
+
+    //sustained pressure is reported as aftertouch
+    for (size_t i = 1; i < reports.size(); i++)
+        TEST_ASSERT(reports.at(i).velocity & ANALOG_FSR_PRESSURE_FLAG);
+}
+
+TEST_CASE(Release)
+{
+    const uint16_t peak = FSR_MAX_VALUE;
+
+    auto readings = sampleStrike(peak, 3, (ONSET_THRESHOLD + RELEASE_THRESHOLD) / 2, 0, 60);
+
+    //pressure between release and onset threshold - sensor should still be pressed
+    auto reports = pipeline(readings);
+
+    TEST_ASSERT(reports.size() > 0);
+
+    for (size_t i = 0; i < reports.size(); i++)
+        TEST_ASSERT(reports.at(i).velocity > 0);
+
+    //now release the sensor and press it again
+    for (int i = 0; i < 10; i++)
+        readings.push_back(0);
+
+    auto second = sampleStrike(peak / 2, 3, 0, 0, 30);
+    readings.insert(readings.end(), second.begin(), second.end());
+
+    reports = pipeline(readings);
+
+    size_t releases = 0;
+    size_t strikes  = 0;
+    bool   pressed  = false;
+
+    for (size_t i = 0; i < reports.size(); i++)
+    {
+        if (!reports.at(i).velocity)
+        {
+            releases++;
+            pressed = false;
+        }
+        else if (!pressed)
+        {
+            strikes++;
+            pressed = true;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(2, strikes);
+    TEST_ASSERT_EQUAL_UINT32(2, releases);
+}
+
+TEST_CASE(Noise)
+{
+    std::vector<uint16_t> readings;
+
+    //noise below onset threshold shouldn't be reported at all
+    for (int i = 0; i < 100; i++)
+        readings.push_back(i % 2 ? ONSET_THRESHOLD - 1 : 0);
+
+    TEST_ASSERT_EQUAL_UINT32(0, pipeline(readings).size());
+}
+
+TEST_CASE(Phase)
+{
+    //the same strike sampled at different phases should result in nearly the same velocity
+    const uint16_t peak = (FSR_MIN_VALUE + FSR_MAX_VALUE) / 2;
+
+    for (int i = 0; i < 10; i++)
+    {
+        auto reports = pipeline(sampleStrike(peak, 6, 0, i / 10.0, 40));
+
+        TEST_ASSERT(reports.size() > 0);
+        TEST_ASSERT(abs(reports.front().velocity - expectedVelocity(peak)) <= 2);
+    }
+}
+
+TEST_CASE(Velocity)
+{
+    //stronger strikes should result in higher velocity
+    uint16_t lastVelocity = 0;
+
+    for (uint16_t peak = FSR_MIN_VALUE; peak <= FSR_MAX_VALUE; peak += (FSR_MAX_VALUE - FSR_MIN_VALUE) / 10)
+    {
+        auto reports = pipeline(sampleStrike(peak, 4, 0, 0, 40));
+
+        TEST_ASSERT(reports.size() > 0);
+        TEST_ASSERT(reports.front().velocity >= lastVelocity);
+        lastVelocity = reports.front().velocity;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, lastVelocity);
+}
+
+TEST_CASE(SlowPress)
+{
+    //pressure which keeps rising should be reported once the window expires
+    std::vector<uint16_t> readings;
+
+    for (int i = 0; i < PEAK_WINDOW * 4; i++)
+        readings.push_back(ONSET_THRESHOLD + i);
+
+    auto reports = pipeline(readings);
+
+    TEST_ASSERT(reports.size() > 0);
+    TEST_ASSERT_EQUAL_UINT32(PEAK_WINDOW, reports.front().sample);
+    TEST_ASSERT_EQUAL_UINT32(expectedVelocity(ONSET_THRESHOLD + PEAK_WINDOW), reports.front().velocity);
+}
+
+TEST_CASE(Aftertouch)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::analog_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::analog_t::type, i, static_cast<int32_t>(Analog::type_t::fsr)) == true);
+        TEST_ASSERT(database.update(Database::Section::analog_t::aftertouchType, i, static_cast<int32_t>(Analog::aftertouchType_t::poly)) == true);
+    }
+
+    //limit aftertouch to 10 messages per second for all pads together
+    TEST_ASSERT(database.update(Database::Section::analog_t::global, static_cast<size_t>(Analog::setting_t::aftertouchRate), 1) == true);
+
+    core::timing::detail::rTime_ms = 0;
+    analog.init();
+
+    //strike all pads
+    hwaAnalog.adcReturnValue = 100;
+    analog.update();
+
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ANALOG, hwaMIDI.midiPacket.size());
+
+    for (int i = 0; i < hwaMIDI.midiPacket.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint8_t>(MIDI::messageType_t::noteOn), hwaMIDI.midiPacket.at(i).Event << 4);
+
+    hwaMIDI.midiPacket.clear();
+
+    //increase pressure on all pads every millisecond during 200 ms
+    for (int i = 1; i <= 200; i++)
+    {
+        core::timing::detail::rTime_ms++;
+        hwaAnalog.adcReturnValue = ANALOG_FSR_PRESSURE_FLAG | (i * MIDI_7_BIT_VALUE_MAX / 200);
+        analog.update();
+    }
+
+    //total rate is limited regardless of the amount of pads
+    TEST_ASSERT_EQUAL_UINT32(2, hwaMIDI.midiPacket.size());
+
+    //pressure doesn't change anymore - the latest one should eventually be sent for all pads
+    //second message has been sent at the end of the rise and already holds the latest pressure
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
+        core::timing::detail::rTime_ms += 100;
+        analog.update();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ANALOG + 1, hwaMIDI.midiPacket.size());
+
+    for (int i = 0; i < hwaMIDI.midiPacket.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint8_t>(MIDI::messageType_t::afterTouchPoly), hwaMIDI.midiPacket.at(i).Event << 4);
+
+    for (int i = 1; i < hwaMIDI.midiPacket.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(MIDI_7_BIT_VALUE_MAX, hwaMIDI.midiPacket.at(i).Data3);
+
+    hwaMIDI.midiPacket.clear();
+
+    //changes below the threshold shouldn't be sent
+    core::timing::detail::rTime_ms += 1000;
+    hwaAnalog.adcReturnValue = ANALOG_FSR_PRESSURE_FLAG | (MIDI_7_BIT_VALUE_MAX - 1);
+    analog.update();
+
+    TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.midiPacket.size());
+
+    //release - only note off should be sent for poly aftertouch
+    hwaAnalog.adcReturnValue = 0;
+    analog.update();
+    core::timing::detail::rTime_ms += 1000;
+    analog.update();
+
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ANALOG, hwaMIDI.midiPacket.size());
+
+    for (int i = 0; i < hwaMIDI.midiPacket.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint8_t>(MIDI::messageType_t::noteOff), hwaMIDI.midiPacket.at(i).Event << 4);
+}
+
+#endif
@@ -116,10 +116,27 @@ namespace
         public:
         HWAAnalog() {}
 
-        bool value(size_t index, uint16_t& value) override
+        void setScanState(size_t index, bool state) override
+        {
+        }
+
+        void setOversamplingState(size_t index, bool state) override
+        {
+        }
+
+        void setPeakDetectionState(size_t index, bool state) override
         {
-            value = adcReturnValue;
-            return true;
+        }
+
+        size_t newValues(uint8_t* indexes, uint16_t* values, size_t maxValues) override
+        {
+            for (size_t i = 0; i < maxValues; i++)
+            {
+                indexes[i] = i;
+                values[i]  = adcReturnValue;
+            }
+
+            return maxValues;
         }
 
         uint32_t adcReturnValue;
@@ -167,6 +184,10 @@ namespace
         void reset(size_t index) override
         {
         }
+
+        void setNoiseThreshold(size_t index, uint16_t threshold) override
+        {
+        }
     } analogFilter;
 
     IO::U8X8    u8x8(hwaU8X8);
@@ -219,6 +240,9 @@ TEST_CASE(CCtest)
 
         //midi channel
         TEST_ASSERT(database.update(Database::Section::analog_t::midiChannel, i, 1) == true);
+
+        //apply the configuration
+        analog.updateScaling(i);
     }
 
     //feed all the values from minimum to maximum
@@ -311,6 +335,9 @@ TEST_CASE(PitchBendTest)
 
         //midi channel
         TEST_ASSERT(database.update(Database::Section::analog_t::midiChannel, i, 1) == true);
+
+        //apply the configuration
+        analog.updateScaling(i);
     }
 
     for (int i = 0; i <= 16383; i++)
@@ -402,11 +429,17 @@ TEST_CASE(Inversion)
 
         //midi channel
         TEST_ASSERT(database.update(Database::Section::analog_t::midiChannel, i, 1) == true);
+
+        //apply the configuration
+        analog.updateScaling(i);
     }
 
     //enable inversion
     for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
         TEST_ASSERT(database.update(Database::Section::analog_t::invert, i, 1) == true);
+        analog.updateScaling(i);
+    }
 
     for (int i = 0; i <= 127; i++)
     {
@@ -442,6 +475,7 @@ TEST_CASE(Inversion)
         TEST_ASSERT(database.update(Database::Section::analog_t::invert, i, 1) == true);
         TEST_ASSERT(database.update(Database::Section::analog_t::lowerLimit, i, 127) == true);
         TEST_ASSERT(database.update(Database::Section::analog_t::upperLimit, i, 0) == true);
+        analog.updateScaling(i);
         analog.debounceReset(i);
     }
 
@@ -475,6 +509,7 @@ TEST_CASE(Inversion)
     for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
     {
         TEST_ASSERT(database.update(Database::Section::analog_t::invert, i, 0) == true);
+        analog.updateScaling(i);
         analog.debounceReset(i);
     }
 
@@ -528,6 +563,9 @@ TEST_CASE(Scaling)
 
         //midi channel
         TEST_ASSERT(database.update(Database::Section::analog_t::midiChannel, i, 1) == true);
+
+        //apply the configuration
+        analog.updateScaling(i);
     }
 
     for (int i = 0; i <= 127; i++)
@@ -548,7 +586,10 @@ TEST_CASE(Scaling)
 
     //now scale minimum value as well
     for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
         TEST_ASSERT(database.update(Database::Section::analog_t::lowerLimit, i, scaledLower) == true);
+        analog.updateScaling(i);
+    }
 
     hwaMIDI.midiPacket.clear();
 
@@ -570,6 +611,7 @@ TEST_CASE(Scaling)
     for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
     {
         TEST_ASSERT(database.update(Database::Section::analog_t::invert, i, 1) == true);
+        analog.updateScaling(i);
         analog.debounceReset(i);
     }
 
@@ -588,4 +630,49 @@ TEST_CASE(Scaling)
     }
 }
 
-#endif
\ No newline at end of file
+TEST_CASE(Calibration)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::analog_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::analog_t::type, i, static_cast<int32_t>(Analog::type_t::potentiometerControlChange)) == true);
+
+        //not calibrated by default
+        TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::noiseThreshold, i));
+    }
+
+    analog.init();
+
+    core::timing::detail::rTime_ms = 0;
+    analog.startCalibration();
+    TEST_ASSERT(analog.isCalibrating() == true);
+
+    //simulate noise on inputs at rest
+    for (int i = 0; i < 10; i++)
+    {
+        hwaAnalog.adcReturnValue = i % 2 ? 103 : 100;
+        analog.update();
+    }
+
+    //nothing should be sent while calibrating
+    TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.midiPacket.size());
+    TEST_ASSERT(analog.isCalibrating() == true);
+
+    core::timing::detail::rTime_ms += ANALOG_CALIBRATION_TIME;
+    analog.update();
+
+    TEST_ASSERT(analog.isCalibrating() == false);
+    TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.midiPacket.size());
+
+    //threshold should be just above peak-to-peak noise
+    for (int i = 0; i < MAX_NUMBER_OF_ANALOG; i++)
+        TEST_ASSERT_EQUAL_UINT32(4, database.read(Database::Section::analog_t::noiseThreshold, i));
+
+    //regular processing should continue once the calibration is done
+    analog.update();
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ANALOG, hwaMIDI.midiPacket.size());
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "unity/src/unity.h"
 #include "unity/Helpers.h"
 #include "io/buttons/Buttons.h"
+#include "io/buttons/Filter.h"
 #include "io/leds/LEDs.h"
 #include "io/common/CInfo.h"
 #include "midi/src/MIDI.h"
@@ -12,7 +13,8 @@
 
 namespace
 {
-    bool buttonState[MAX_NUMBER_OF_BUTTONS] = {};
+    bool     buttonState[MAX_NUMBER_OF_BUTTONS] = {};
+    uint32_t buttonStateTime                    = 0;
 
     class DBhandlers : public Database::Handlers
     {
@@ -120,13 +122,24 @@ namespace
         {
             return buttonState[index];
         }
+
+        uint32_t stateTime() override
+        {
+            return buttonStateTime;
+        }
+
+        uint32_t currentTime() override
+        {
+            return buttonStateTime;
+        }
     } hwaButtons;
 
     class ButtonsFilter : public IO::Buttons::Filter
     {
         public:
-        bool isFiltered(size_t index, bool value, bool& filteredValue) override
+        bool isFiltered(size_t index, bool value, uint32_t time, uint32_t debounceTime, IO::Buttons::debounceMode_t debounceMode, bool& filteredValue) override
         {
+            filteredValue = value;
             return true;
         }
 
@@ -167,6 +180,8 @@ namespace
     IO::Display display(u8x8, database);
     IO::Buttons buttons = IO::Buttons(hwaButtons, buttonsFilter, database, midi, leds, display, cInfo);
 
+    std::vector<size_t> cInfoMIDIcount;
+
     void stateChangeRegister(bool state)
     {
         hwaMIDI.midiPacket.clear();
@@ -182,6 +197,7 @@ TEST_SETUP()
     TEST_ASSERT(database.init() == true);
     //always start from known state
     database.factoryReset();
+    buttons.init();
 
     midi.init();
     midi.setChannelSendZeroStart(true);
@@ -239,7 +255,10 @@ TEST_CASE(Note)
 
         // try with the latching mode
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        {
             TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+            buttons.buildAction(i);
+        }
 
         stateChangeRegister(true);
         TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -318,7 +337,10 @@ TEST_CASE(ProgramChange)
         //repeat the entire test again, but with buttons configured as latching types
         //behaviour should be the same
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        {
             TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+            buttons.buildAction(i);
+        }
 
         stateChangeRegister(true);
         TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -335,6 +357,7 @@ TEST_CASE(ProgramChange)
     //test programChangeInc/programChangeDec
     //revert to default database state first
     database.factoryReset();
+    buttons.init();
     stateChangeRegister(false);
 
     auto configurePCbutton = [&](uint8_t buttonID, uint8_t channel, bool increase) {
@@ -543,7 +566,10 @@ TEST_CASE(ControlChange)
         //behaviour should be the same
 
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        {
             TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+            buttons.buildAction(i);
+        }
 
         stateChangeRegister(true);
         TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -578,7 +604,10 @@ TEST_CASE(ControlChange)
         //on second press reset should be sent (CC with value 0)
 
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        {
             TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+            buttons.buildAction(i);
+        }
 
         stateChangeRegister(true);
         TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -624,7 +653,10 @@ TEST_CASE(NoMessages)
     TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
 
     for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+    {
         TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+        buttons.buildAction(i);
+    }
 
     stateChangeRegister(true);
     TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
@@ -688,7 +720,10 @@ TEST_CASE(LocalLEDcontrol)
 
     //test again in latching mode
     for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+    {
         TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::latching)) == true);
+        buttons.buildAction(i);
+    }
 
     stateChangeRegister(true);
     TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -747,6 +782,7 @@ TEST_CASE(LocalLEDcontrol)
 
     //change the control value for button 0 to something else
     TEST_ASSERT(database.update(Database::Section::button_t::velocity, 0, 126) == true);
+    buttons.buildAction(0);
 
     stateChangeRegister(true);
     TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
@@ -780,4 +816,302 @@ TEST_CASE(LocalLEDcontrol)
 }
 #endif
 
-#endif
\ No newline at end of file
+TEST_CASE(DebounceTime)
+{
+    using namespace IO;
+
+    IO::ButtonsFilter filter;
+    bool              state;
+
+    //state should be accepted once it's stable for the entire debounce time
+    TEST_ASSERT(filter.isFiltered(0, true, 0, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, true, 500, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, true, 1000, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, true, 1500, 1500, Buttons::debounceMode_t::stable, state) == true);
+    TEST_ASSERT(state == true);
+
+    //each change should restart the debounce time
+    TEST_ASSERT(filter.isFiltered(0, false, 2000, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, true, 2500, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, false, 3000, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, false, 4000, 1500, Buttons::debounceMode_t::stable, state) == false);
+    TEST_ASSERT(filter.isFiltered(0, false, 4500, 1500, Buttons::debounceMode_t::stable, state) == true);
+    TEST_ASSERT(state == false);
+
+    //other buttons shouldn't be affected
+    TEST_ASSERT(filter.isFiltered(1, false, 4500, 1500, Buttons::debounceMode_t::stable, state) == true);
+
+    //state should be accepted immediately without debounce time
+    TEST_ASSERT(filter.isFiltered(2, true, 5000, 0, Buttons::debounceMode_t::stable, state) == true);
+    TEST_ASSERT(state == true);
+
+    //time of the state change should be available to the application
+    buttons.processButton(0, true, 12345);
+    TEST_ASSERT_EQUAL_UINT32(12345, buttons.getStateChangeTime(0));
+
+    //time shouldn't change if the state is the same
+    buttons.processButton(0, true, 23456);
+    TEST_ASSERT_EQUAL_UINT32(12345, buttons.getStateChangeTime(0));
+
+    //buttons which aren't read through HWA should use the same clock
+    buttonStateTime = 34567;
+    buttons.processButton(1, true);
+    TEST_ASSERT_EQUAL_UINT32(34567, buttons.getStateChangeTime(1));
+}
+
+TEST_CASE(EagerDebounce)
+{
+    using namespace IO;
+
+    IO::ButtonsFilter filter;
+    bool              state;
+
+    auto eager = [&](bool value, uint32_t time) {
+        TEST_ASSERT(filter.isFiltered(0, value, time, 1500, Buttons::debounceMode_t::eager, state) == true);
+        return state;
+    };
+
+    //first change after stable period should be reported immediately
+    TEST_ASSERT(eager(false, 10000) == false);
+    TEST_ASSERT(eager(true, 10500) == true);
+
+    //bounces during debounce time should be ignored
+    TEST_ASSERT(eager(false, 11000) == true);
+    TEST_ASSERT(eager(true, 11500) == true);
+    TEST_ASSERT(eager(false, 11500) == true);
+
+    //once debounce time passes, release should be reported immediately
+    TEST_ASSERT(eager(true, 12000) == true);
+    TEST_ASSERT(eager(false, 12500) == false);
+
+    //release which happened during debounce time should be reported once debounce time passes
+    TEST_ASSERT(eager(true, 14500) == true);
+    TEST_ASSERT(eager(false, 15000) == true);
+    TEST_ASSERT(eager(false, 16000) == false);
+
+    //long stable period shouldn't delay next press
+    for (uint32_t time = 16500; time < 500000; time += 500)
+        TEST_ASSERT(eager(false, time) == false);
+
+    TEST_ASSERT(eager(true, 500000) == true);
+}
+
+TEST_CASE(Batch)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::button_t::type, i, static_cast<int32_t>(Buttons::type_t::momentary)) == true);
+        TEST_ASSERT(database.update(Database::Section::button_t::midiMessage, i, static_cast<int32_t>(Buttons::messageType_t::note)) == true);
+        buttons.reset(i);
+    }
+
+    //record amount of sent MIDI messages at the moment component info is sent
+    cInfoMIDIcount.clear();
+
+    cInfo.registerHandler([](Database::block_t block, SysExConf::sysExParameter_t id) {
+        cInfoMIDIcount.push_back(hwaMIDI.midiPacket.size());
+        return true;
+    });
+
+    //press all buttons at once
+    hwaMIDI.midiPacket.clear();
+
+    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        buttonState[i] = true;
+
+    buttons.update();
+
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_BUTTONS);
+    TEST_ASSERT(cInfoMIDIcount.size() == MAX_NUMBER_OF_BUTTONS);
+
+    //all MIDI messages in a batch should be sent before any other side effect
+    for (size_t i = 0; i < cInfoMIDIcount.size(); i++)
+    {
+        size_t batchEnd = ((i / BUTTONS_MAX_BATCH_SIZE) + 1) * BUTTONS_MAX_BATCH_SIZE;
+
+        if (batchEnd > MAX_NUMBER_OF_BUTTONS)
+            batchEnd = MAX_NUMBER_OF_BUTTONS;
+
+        TEST_ASSERT(cInfoMIDIcount.at(i) == batchEnd);
+    }
+
+    //state changes processed outside of update should be indicated immediately
+    cInfoMIDIcount.clear();
+    stateChangeRegister(false);
+
+    for (size_t i = 0; i < cInfoMIDIcount.size(); i++)
+        TEST_ASSERT(cInfoMIDIcount.at(i) == (i + 1));
+
+    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        buttonState[i] = false;
+
+    cInfo.registerHandler(nullptr);
+}
+
+TEST_CASE(Gestures)
+{
+    using namespace IO;
+
+    midi.setNoteOffMode(MIDI::noteOffType_t::standardNoteOff);
+
+    TEST_ASSERT(database.update(Database::Section::button_t::type, 0, static_cast<int32_t>(Buttons::type_t::momentary)) == true);
+    TEST_ASSERT(database.update(Database::Section::button_t::midiMessage, 0, static_cast<int32_t>(Buttons::messageType_t::note)) == true);
+    TEST_ASSERT(database.update(Database::Section::button_t::longPressMIDIid, 0, 10) == true);
+    TEST_ASSERT(database.update(Database::Section::button_t::doubleTapMIDIid, 0, 20) == true);
+
+    //use default gesture times: 500ms long press, 300ms double tap and 100ms repeat
+    auto read = [&](bool state, uint32_t timeMs) {
+        hwaMIDI.midiPacket.clear();
+        buttonState[0]  = state;
+        buttonStateTime = timeMs * 1000;
+        buttons.update();
+    };
+
+    auto verify = [&](size_t index, MIDI::messageType_t message, uint8_t note) {
+        TEST_ASSERT(static_cast<uint8_t>(message) == static_cast<uint8_t>(hwaMIDI.midiPacket.at(index).Event << 4));
+        TEST_ASSERT(note == hwaMIDI.midiPacket.at(index).Data2);
+    };
+
+    //long press
+    TEST_ASSERT(database.update(Database::Section::button_t::longPress, 0, 1) == true);
+    buttons.buildAction(0);
+
+    read(true, 1000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    verify(0, MIDI::messageType_t::noteOn, 0);
+
+    read(true, 1490);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
+
+    read(true, 1500);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    verify(0, MIDI::messageType_t::noteOn, 10);
+
+    //long press message should be released together with the button
+    read(false, 1600);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 2);
+    verify(0, MIDI::messageType_t::noteOff, 0);
+    verify(1, MIDI::messageType_t::noteOff, 10);
+
+    //short press shouldn't trigger long press
+    read(true, 2000);
+    read(false, 2400);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    verify(0, MIDI::messageType_t::noteOff, 0);
+
+    read(false, 3000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
+
+    //double tap
+    TEST_ASSERT(database.update(Database::Section::button_t::longPress, 0, 0) == true);
+    TEST_ASSERT(database.update(Database::Section::button_t::doubleTap, 0, 1) == true);
+    buttons.buildAction(0);
+
+    read(true, 4000);
+    read(false, 4100);
+    read(true, 4300);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 2);
+    verify(0, MIDI::messageType_t::noteOn, 0);
+    verify(1, MIDI::messageType_t::noteOn, 20);
+
+    read(false, 4400);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 2);
+    verify(0, MIDI::messageType_t::noteOff, 0);
+    verify(1, MIDI::messageType_t::noteOff, 20);
+
+    //press after the double tap window shouldn't be double tap
+    read(true, 5000);
+    read(false, 5100);
+    read(false, 5500);
+    read(true, 5600);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    verify(0, MIDI::messageType_t::noteOn, 0);
+    read(false, 5700);
+
+    //auto-repeat
+    TEST_ASSERT(database.update(Database::Section::button_t::doubleTap, 0, 0) == true);
+    TEST_ASSERT(database.update(Database::Section::button_t::repeat, 0, 1) == true);
+    buttons.buildAction(0);
+
+    read(true, 7000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+
+    //first repeat once the button is held for long press time, then on each repeat interval
+    for (uint32_t time = 7500; time <= 8000; time += 100)
+    {
+        read(true, time);
+        TEST_ASSERT(hwaMIDI.midiPacket.size() == 2);
+        verify(0, MIDI::messageType_t::noteOff, 0);
+        verify(1, MIDI::messageType_t::noteOn, 0);
+
+        read(true, time + 50);
+        TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
+    }
+
+    read(false, 8080);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    verify(0, MIDI::messageType_t::noteOff, 0);
+
+    //repeat shouldn't continue after release
+    read(false, 9000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
+}
+
+TEST_CASE(GesturesPresetChange)
+{
+    using namespace IO;
+
+    if (database.getSupportedPresets() < 2)
+        return;
+
+    midi.setNoteOffMode(MIDI::noteOffType_t::standardNoteOff);
+
+    //same as in application
+    dbHandlers.presetChangeHandler = [](uint8_t preset) {
+        buttons.init();
+    };
+
+    //long press is enabled only in first preset, with different long press ID in each preset
+    for (uint8_t preset = 0; preset < 2; preset++)
+    {
+        TEST_ASSERT(database.setPreset(preset) == true);
+        TEST_ASSERT(database.update(Database::Section::button_t::type, 0, static_cast<int32_t>(Buttons::type_t::momentary)) == true);
+        TEST_ASSERT(database.update(Database::Section::button_t::midiMessage, 0, static_cast<int32_t>(Buttons::messageType_t::note)) == true);
+        TEST_ASSERT(database.update(Database::Section::button_t::longPress, 0, preset ? 0 : 1) == true);
+        TEST_ASSERT(database.update(Database::Section::button_t::longPressMIDIid, 0, preset ? 30 : 10) == true);
+    }
+
+    TEST_ASSERT(database.setPreset(0) == true);
+
+    auto read = [&](bool state, uint32_t timeMs) {
+        hwaMIDI.midiPacket.clear();
+        buttonState[0]  = state;
+        buttonStateTime = timeMs * 1000;
+        buttons.update();
+    };
+
+    //release the button in case it was left pressed
+    read(false, 20000);
+
+    read(true, 21000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+
+    //change preset while the button is held - long press armed in previous preset shouldn't fire
+    TEST_ASSERT(database.setPreset(1) == true);
+
+    read(true, 21500);
+    read(true, 22000);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 0);
+
+    read(false, 22100);
+    TEST_ASSERT(hwaMIDI.midiPacket.size() == 1);
+    TEST_ASSERT(static_cast<uint8_t>(MIDI::messageType_t::noteOff) == static_cast<uint8_t>(hwaMIDI.midiPacket.at(0).Event << 4));
+    TEST_ASSERT(0 == hwaMIDI.midiPacket.at(0).Data2);
+
+    TEST_ASSERT(database.setPreset(0) == true);
+    dbHandlers.presetChangeHandler = nullptr;
+}
+
+#endif
@@ -90,10 +90,39 @@ namespace
         HWAEncoders()
         {}
 
-        uint8_t state(size_t index) override
+        uint8_t readings() override
+        {
+            //generate new readings for all encoders
+            for (int i = 0; i < readingsPerUpdate; i++)
+            {
+                for (int j = 0; j < IO::Encoders::NUMBER_OF_GROUPS; j++)
+                    states[i][j] = 0;
+
+                for (int j = 0; j < MAX_NUMBER_OF_ENCODERS; j++)
+                    states[i][j / IO::Encoders::ENCODERS_PER_GROUP] |= reading(j) << ((j % IO::Encoders::ENCODERS_PER_GROUP) * 2);
+            }
+
+            return readingsPerUpdate;
+        }
+
+        uint8_t state(uint8_t reading, uint8_t group) override
+        {
+            return states[reading][group];
+        }
+
+        uint32_t readingTime(uint8_t reading) override
+        {
+            return timeUs + reading * readingPeriodUs;
+        }
+
+        uint8_t reading(size_t index)
         {
             uint8_t returnValue = 0;
 
+            //stopped encoder keeps its last state
+            if (encoderPosition[index] == IO::Encoders::position_t::stopped)
+                return lastState[index];
+
             if (encoderPosition[index] == IO::Encoders::position_t::ccw)
             {
                 returnValue = stateArray[stateCounter[index]];
@@ -110,7 +139,7 @@ namespace
             }
 
             if (returnValue == lastState[index])
-                return state(index);
+                return reading(index);
 
             lastState[index] = returnValue;
             return returnValue;
@@ -123,6 +152,15 @@ namespace
 
         IO::Encoders::position_t encoderPosition[MAX_NUMBER_OF_ENCODERS];
 
+        //amount of readings returned on each call to state
+        uint8_t readingsPerUpdate = 1;
+
+        uint8_t states[IO::Encoders::MAX_READINGS][IO::Encoders::NUMBER_OF_GROUPS] = {};
+
+        //time of the first reading returned on each call to readings and time between two readings
+        uint32_t timeUs          = 0;
+        uint32_t readingPeriodUs = 500;
+
         int8_t  stateCounter[MAX_NUMBER_OF_ENCODERS] = {};
         uint8_t lastState[MAX_NUMBER_OF_ENCODERS]    = {};
 
@@ -172,6 +210,8 @@ TEST_SETUP()
     encoders.init();
     midi.init();
     midi.enableUSBMIDI();
+    hwaEncoders.readingsPerUpdate = 1;
+    hwaEncoders.timeUs            = 0;
 }
 
 TEST_CASE(StateDecoding)
@@ -647,107 +687,423 @@ TEST_CASE(Acceleration)
 {
     using namespace IO;
 
-    auto accelerationTest = [&](uint8_t pulsesPerStep) {
-#define ENCODER_SPEED_CHANGE 3
-        //set known state
-        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
-        {
-            //enable all encoders
-            TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+    //set known state
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
 
-            //disable invert state
-            TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        //pitch bend is used so that the value doesn't reach the limit quickly
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::tPitchBend)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, static_cast<int32_t>(Encoders::acceleration_t::medium)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+        hwaEncoders.setEncoderState(i, Encoders::position_t::cw);
+    }
 
-            //set type of message to Encoders::type_t::tControlChange
-            TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::tControlChange)) == true);
+    //returns value from last pitch bend message of first encoder, or -1 if there are no messages
+    auto lastValue = [&]() {
+        int32_t value = -1;
 
-            //enable acceleration
-            TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, ENCODER_SPEED_CHANGE) == true);
+        for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i += MAX_NUMBER_OF_ENCODERS)
+            value = hwaMIDI.midiPacket.at(i).Data2 | (hwaMIDI.midiPacket.at(i).Data3 << 7);
 
-            //pulses per step
-            TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, pulsesPerStep) == true);
+        hwaMIDI.midiPacket.clear();
+        return value;
+    };
 
-            //midi channel
-            TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
-        }
+    //rotates the encoders at constant speed for specified amount of detents and
+    //returns the total change of value
+    auto spin = [&](uint8_t readingsPerUpdate, uint32_t detentTime, size_t detents) {
+        hwaEncoders.readingsPerUpdate = readingsPerUpdate;
+        hwaEncoders.readingPeriodUs   = detentTime;
+        hwaEncoders.timeUs            = 0;
 
         encoders.init();
+        hwaMIDI.midiPacket.clear();
 
-        //all encoders should move in the same direction
-        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
-            hwaEncoders.setEncoderState(i, Encoders::position_t::cw);
+        int32_t value = 8192;
 
-        core::timing::detail::rTime_ms = 1;
+        //first reading after init is used as reference only
+        for (size_t reading = 0; reading < (detents + 1); reading += readingsPerUpdate)
+        {
+            encoders.update();
+            hwaEncoders.timeUs += readingsPerUpdate * detentTime;
 
-        uint16_t lastValue = 0;
+            int32_t newValue = lastValue();
 
-        auto update = [&](uint8_t compareValue) {
-            bool success;
+            if (newValue != -1)
+                value = newValue;
+        }
 
-            for (int j = 0; j < 4 + 1; j++)
-            {
-                success = false;
-                encoders.update();
+        return value - 8192;
+    };
 
-                if (compareValue > 127)
-                    compareValue = 127;
+    //slow movement shouldn't be accelerated
+    TEST_ASSERT_EQUAL_INT32(20, spin(1, 100000, 20));
 
-                if (hwaMIDI.midiPacket.size() == MAX_NUMBER_OF_ENCODERS)
-                {
-                    //verify that all received values are correct
-                    for (int k = 0; k < MAX_NUMBER_OF_ENCODERS; k++)
-                    {
-                        if (hwaMIDI.midiPacket.at(k).Data3 != compareValue)
-                        {
-                            success = false;
-                            break;
-                        }
-                        else
-                        {
-                            success = true;
-                        }
-                    }
+    //fast movement should be accelerated, but below the maximum of 37 steps per detent (10 steps, 4 times larger in 14-bit mode)
+    int32_t change = spin(1, 20000, 64);
 
-                    if (success)
-                    {
-                        lastValue = hwaMIDI.midiPacket.at(0).Data3;
-                        break;
-                    }
-                }
-            }
+    TEST_ASSERT(change > 64);
+    TEST_ASSERT(change < (64 * 37));
 
-            TEST_ASSERT(success == true);
-        };
+    //result shouldn't depend on the amount of readings processed in single update
+    TEST_ASSERT_EQUAL_INT32(change, spin(5, 20000, 64));
+
+    //speed up gradually: amount of steps per detent should rise smoothly up to the maximum
+    hwaEncoders.readingsPerUpdate = 1;
+    hwaEncoders.timeUs            = 0;
+    encoders.init();
+    hwaMIDI.midiPacket.clear();
+
+    encoders.update();
+    lastValue();
+
+    int32_t previousValue = 8192;
+    int32_t previousDelta = 1;
+
+    for (uint32_t interval = 80000; interval >= 2000; interval -= 2000)
+    {
+        hwaEncoders.timeUs += interval;
+        encoders.update();
+
+        int32_t value = lastValue();
+        int32_t delta = value - previousValue;
+
+        TEST_ASSERT(delta >= previousDelta);
+        TEST_ASSERT(delta <= (previousDelta + 8));
+
+        previousValue = value;
+        previousDelta = delta;
+    }
+
+    TEST_ASSERT_EQUAL_INT32(37, previousDelta);
+
+    //stop for a while - acceleration should be reset
+    hwaEncoders.timeUs += ENCODERS_SPEED_TIMEOUT + 1;
+    encoders.update();
+
+    TEST_ASSERT_EQUAL_INT32(previousValue + 1, lastValue());
+}
+
+TEST_CASE(MultipleReadings)
+{
+    using namespace IO;
+
+    //set known state
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::t7Fh01h)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, 4) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+    }
+
+    auto verify = [&](uint8_t value) {
+        //single message per encoder is expected regardless of the amount of steps
+        TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, hwaMIDI.midiPacket.size());
+
+        for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i++)
+            TEST_ASSERT_EQUAL_UINT32(value, hwaMIDI.midiPacket.at(i).Data3);
+
+        hwaMIDI.midiPacket.clear();
+    };
+
+    //simulate slow main loop: 8 readings are available on each update
+    //first reading after init is used as reference only, so 7 pulses are registered in first
+    //update (one step, 3 pulses left) and 8 pulses in each following update (two steps)
+    hwaEncoders.readingsPerUpdate = 8;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        hwaEncoders.setEncoderState(i, Encoders::position_t::cw);
+
+    core::timing::detail::rTime_ms = 0;
+    encoders.init();
+    hwaMIDI.midiPacket.clear();
+
+    encoders.update();
+    verify(1);
+
+    encoders.update();
+    verify(2);
+
+    //same in the other direction in 3Fh41h mode
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::t3Fh41h)) == true);
+        hwaEncoders.setEncoderState(i, Encoders::position_t::ccw);
+    }
+
+    core::timing::detail::rTime_ms += ENCODERS_DEBOUNCE_RESET_TIME + 1;
+    encoders.init();
+
+    encoders.update();
+    verify(63);
+
+    encoders.update();
+    verify(62);
+
+    //absolute mode should contain the final value
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::tControlChange)) == true);
+        hwaEncoders.setEncoderState(i, Encoders::position_t::cw);
+    }
+
+    core::timing::detail::rTime_ms += ENCODERS_DEBOUNCE_RESET_TIME + 1;
+    encoders.init();
+
+    encoders.update();
+    verify(1);
+
+    encoders.update();
+    verify(3);
 
-        //run update several times, each time increasing the run time by 1
-        //encoder state is same every time (cw direction)
-        //this will cause acceleration to kick in
-        //verify the outputed values
-        //acceleration works by appending ENCODER_SPEED_CHANGE+previous value to
-        //to current encoder midi value
-        for (int i = 1; i <= 3; i++)
+    encoders.update();
+    verify(5);
+}
+
+TEST_CASE(MovingEncodersOnly)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::t7Fh01h)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, 4) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiID, i, i) == true);
+
+        //move every third encoder only
+        hwaEncoders.setEncoderState(i, (i % 3) ? Encoders::position_t::stopped : Encoders::position_t::cw);
+    }
+
+    hwaEncoders.readingsPerUpdate = 5;
+    encoders.init();
+    hwaMIDI.midiPacket.clear();
+
+    //5 readings: first one is used as reference, four pulses make single step
+    encoders.update();
+
+    size_t moving = (MAX_NUMBER_OF_ENCODERS + 2) / 3;
+
+    TEST_ASSERT_EQUAL_UINT32(moving, hwaMIDI.midiPacket.size());
+
+    for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i++)
+    {
+        //control change number matches encoder index
+        TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.midiPacket.at(i).Data2 % 3);
+        TEST_ASSERT_EQUAL_UINT32(1, hwaMIDI.midiPacket.at(i).Data3);
+    }
+
+    //no movement - no messages
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        hwaEncoders.setEncoderState(i, Encoders::position_t::stopped);
+
+    hwaMIDI.midiPacket.clear();
+    encoders.update();
+
+    TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.midiPacket.size());
+}
+
+TEST_CASE(RelativeEncodings)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, static_cast<int32_t>(Encoders::acceleration_t::disabled)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiID, i, i) == true);
+    }
+
+    //rotates all encoders for 7 steps in single update (8 readings, first one is reference)
+    //and verifies that all encoders have sent the expected value in single message
+    auto verify = [&](Encoders::type_t type, Encoders::position_t position, uint16_t value) {
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
         {
-            hwaMIDI.midiPacket.clear();
-            core::timing::detail::rTime_ms++;
-            uint16_t compareValue = lastValue + (ENCODER_SPEED_CHANGE * i);
-            update(compareValue);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(type)) == true);
+            hwaEncoders.setEncoderState(i, position);
         }
 
-        //now run update again but with time difference between movements being
-        //just enough so that encoder doesn't accelerate
-        //in this case, existing values should be increased only by 1
-        for (int i = 1; i <= 3; i++)
+        core::timing::detail::rTime_ms += ENCODERS_DEBOUNCE_RESET_TIME + 1;
+        hwaEncoders.readingsPerUpdate = 8;
+        encoders.init();
+        hwaMIDI.midiPacket.clear();
+        encoders.update();
+
+        if (type == Encoders::type_t::t1FFFh2001h)
         {
-            hwaMIDI.midiPacket.clear();
-            core::timing::detail::rTime_ms += ENCODERS_SPEED_TIMEOUT;
-            uint16_t compareValue = lastValue + 1;
-            update(compareValue);
+            //msb and lsb
+            TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS * 2, hwaMIDI.midiPacket.size());
+
+            for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i += 2)
+            {
+                TEST_ASSERT_EQUAL_UINT32(hwaMIDI.midiPacket.at(i).Data2 + 32, hwaMIDI.midiPacket.at(i + 1).Data2);
+                TEST_ASSERT_EQUAL_UINT32(value, (hwaMIDI.midiPacket.at(i).Data3 << 7) | hwaMIDI.midiPacket.at(i + 1).Data3);
+            }
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, hwaMIDI.midiPacket.size());
+
+            for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i++)
+                TEST_ASSERT_EQUAL_UINT32(value, hwaMIDI.midiPacket.at(i).Data3);
+        }
+    };
+
+    verify(Encoders::type_t::t7Fh01h, Encoders::position_t::cw, 7);
+    verify(Encoders::type_t::t7Fh01h, Encoders::position_t::ccw, 0x80 - 7);
+    verify(Encoders::type_t::t3Fh41h, Encoders::position_t::cw, 64 + 7);
+    verify(Encoders::type_t::t3Fh41h, Encoders::position_t::ccw, 64 - 7);
+    verify(Encoders::type_t::t41h01h, Encoders::position_t::cw, 7);
+    verify(Encoders::type_t::t41h01h, Encoders::position_t::ccw, 0x40 | 7);
+    verify(Encoders::type_t::t1FFFh2001h, Encoders::position_t::cw, 8192 + 7);
+    verify(Encoders::type_t::t1FFFh2001h, Encoders::position_t::ccw, 8192 - 7);
+
+    //fast rotation - accelerated steps should be sent in single message
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, static_cast<int32_t>(Encoders::acceleration_t::fast)) == true);
+
+    hwaEncoders.readingPeriodUs = 1000;
+
+    for (int i = 0; i < 4; i++)
+    {
+        hwaMIDI.midiPacket.clear();
+        hwaEncoders.timeUs += 8 * hwaEncoders.readingPeriodUs;
+        encoders.update();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS * 2, hwaMIDI.midiPacket.size());
+
+    //ccw direction, 8 steps in single update, each producing more than one step
+    uint16_t value = (hwaMIDI.midiPacket.at(0).Data3 << 7) | hwaMIDI.midiPacket.at(1).Data3;
+    TEST_ASSERT(value < (8192 - 8));
+}
+
+TEST_CASE(RemoteSync)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::tControlChange)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, static_cast<int32_t>(Encoders::acceleration_t::disabled)) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+        TEST_ASSERT(database.update(Database::Section::encoder_t::midiID, i, i) == true);
+
+        hwaEncoders.setEncoderState(i, Encoders::position_t::stopped);
+    }
+
+    hwaEncoders.readingsPerUpdate = 1;
+    encoders.init();
+
+    //first reading is used as reference
+    encoders.update();
+
+    //moves first encoder for single step and verifies the sent value
+    auto verify = [&](uint16_t value) {
+        hwaMIDI.midiPacket.clear();
+        hwaEncoders.setEncoderState(0, Encoders::position_t::cw);
+        encoders.update();
+        hwaEncoders.setEncoderState(0, Encoders::position_t::stopped);
+
+        TEST_ASSERT_EQUAL_UINT32(1, hwaMIDI.midiPacket.size());
+        TEST_ASSERT_EQUAL_UINT32(value, hwaMIDI.midiPacket.at(0).Data3);
+    };
+
+    //multiple values received before the update - only the last one should be applied
+    encoders.setValue(0, 50);
+    encoders.setValue(0, 100);
+    encoders.update();
+    verify(101);
+
+    //value received right after the local movement should be ignored
+    encoders.setValue(0, 20);
+    encoders.update();
+    verify(102);
+
+    //value received before local movement processed in the same update should be ignored
+    core::timing::detail::rTime_ms += ENCODERS_REMOTE_SYNC_GRACE_TIME;
+    encoders.setValue(0, 20);
+    verify(103);
+
+    //value received once the grace time has passed should be applied
+    core::timing::detail::rTime_ms += ENCODERS_REMOTE_SYNC_GRACE_TIME;
+    encoders.setValue(0, 30);
+    encoders.update();
+    verify(31);
+
+    //pending value should be discarded on reset
+    core::timing::detail::rTime_ms += ENCODERS_REMOTE_SYNC_GRACE_TIME;
+    encoders.setValue(0, 60);
+    encoders.resetValue(0);
+    encoders.update();
+    verify(1);
+}
+
+TEST_CASE(PresetChange)
+{
+    using namespace IO;
+
+    if (database.getSupportedPresets() < 2)
+        return;
+
+    //same as in application
+    dbHandlers.presetChangeHandler = [](uint8_t preset) {
+        encoders.init();
+    };
+
+    //use different amount of pulses per step in each preset
+    for (uint8_t preset = 0; preset < 2; preset++)
+    {
+        TEST_ASSERT(database.setPreset(preset) == true);
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+            TEST_ASSERT(database.update(Database::Section::encoder_t::enable, i, 1) == true);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::invert, i, 0) == true);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::mode, i, static_cast<int32_t>(Encoders::type_t::t7Fh01h)) == true);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::acceleration, i, static_cast<int32_t>(Encoders::acceleration_t::disabled)) == true);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::pulsesPerStep, i, preset ? 1 : 4) == true);
+            TEST_ASSERT(database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
         }
+    }
+
+    //rotates all encoders for 7 pulses in single update (8 readings, first one is reference)
+    //and verifies the amount of steps sent
+    auto verify = [&](uint8_t preset, uint8_t steps) {
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            hwaEncoders.setEncoderState(i, Encoders::position_t::cw);
+
+        core::timing::detail::rTime_ms += ENCODERS_DEBOUNCE_RESET_TIME + 1;
+        hwaEncoders.readingsPerUpdate = 8;
+
+        TEST_ASSERT(database.setPreset(preset) == true);
+        hwaMIDI.midiPacket.clear();
+        encoders.update();
+
+        TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, hwaMIDI.midiPacket.size());
+
+        for (size_t i = 0; i < hwaMIDI.midiPacket.size(); i++)
+            TEST_ASSERT_EQUAL_UINT32(steps, hwaMIDI.midiPacket.at(i).Data3);
     };
 
-    accelerationTest(4);
-    accelerationTest(3);
-    accelerationTest(2);
+    verify(1, 7);
+    verify(0, 1);
+
+    dbHandlers.presetChangeHandler = nullptr;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -34,6 +34,22 @@ namespace Board
             TEST_ASSERT(buffer.insert(data) == true);
             return true;
         }
+
+        bool init(uint8_t channel, uint32_t baudRate)
+        {
+            return true;
+        }
+
+        bool deInit(uint8_t channel)
+        {
+            buffer.reset();
+            return true;
+        }
+
+        bool isTxEmpty(uint8_t channel)
+        {
+            return true;
+        }
     }    // namespace UART
 }    // namespace Board
 
@@ -136,16 +152,160 @@ TEST_CASE(ManualPacketBuilding)
     TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, sending.Data3));
     TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, dataXor));
 
-    //there are several reads now which should return failure:
-    //5 more failed reads until wrong XOR packet is cleared out of memory
-    //2 more failed reads for first two bytes
-    for (int i = 0; i < 7; i++)
-        TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+    //unfinished packet should be skipped and valid one should be read immediately
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+    TEST_ASSERT(receivedPacketType == OpenDeckMIDIformat::packetType_t::internalCommand);
+    TEST_ASSERT(rebootType == Board::rebootType_t::rebootBtldr);
+
+    //nothing left in the buffer - read should return false
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+}
+
+TEST_CASE(Burst)
+{
+    MIDI::USBMIDIpacket_t            sending;
+    MIDI::USBMIDIpacket_t            receiving;
+    OpenDeckMIDIformat::packetType_t receivedPacketType;
+
+    sending.Event = static_cast<uint8_t>(MIDI::messageType_t::noteOn);
+    sending.Data2 = 0x20;
+    sending.Data3 = 0x30;
+
+    //queued packets shouldn't be sent until flush is called
+    for (int i = 0; i < 3; i++)
+    {
+        sending.Data1 = i;
+        TEST_ASSERT(OpenDeckMIDIformat::writeMIDI(TEST_MIDI_CHANNEL, sending) == true);
+    }
+
+    TEST_ASSERT(buffer.count() == 0);
+    TEST_ASSERT(OpenDeckMIDIformat::flush(TEST_MIDI_CHANNEL) == true);
+
+    //start byte, number of packets, packets and crc
+    TEST_ASSERT_EQUAL_UINT32(2 + (3 * 4) + 1, buffer.count());
+
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+        TEST_ASSERT(receivedPacketType == OpenDeckMIDIformat::packetType_t::midi);
+        TEST_ASSERT(receiving.Event == static_cast<uint8_t>(MIDI::messageType_t::noteOn));
+        TEST_ASSERT(receiving.Data1 == i);
+        TEST_ASSERT(receiving.Data2 == 0x20);
+        TEST_ASSERT(receiving.Data3 == 0x30);
+    }
+
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+
+    //frame should be sent automatically once maximum number of packets is queued
+    for (int i = 0; i < OpenDeckMIDIformat::MAX_BURST_PACKETS; i++)
+    {
+        sending.Data1 = i;
+        TEST_ASSERT(OpenDeckMIDIformat::writeMIDI(TEST_MIDI_CHANNEL, sending) == true);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(2 + (OpenDeckMIDIformat::MAX_BURST_PACKETS * 4) + 1, buffer.count());
+
+    for (int i = 0; i < OpenDeckMIDIformat::MAX_BURST_PACKETS; i++)
+    {
+        TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+        TEST_ASSERT(receiving.Data1 == i);
+    }
+
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+
+    //single packet write should send queued packets first to preserve the order
+    sending.Data1 = 0x01;
+    TEST_ASSERT(OpenDeckMIDIformat::writeMIDI(TEST_MIDI_CHANNEL, sending) == true);
+    sending.Data1 = 0x02;
+    TEST_ASSERT(OpenDeckMIDIformat::write(TEST_MIDI_CHANNEL, sending, OpenDeckMIDIformat::packetType_t::midi) == true);
+
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+    TEST_ASSERT(receiving.Data1 == 0x01);
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+    TEST_ASSERT(receiving.Data1 == 0x02);
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+}
+
+TEST_CASE(BurstResync)
+{
+    MIDI::USBMIDIpacket_t            sending;
+    MIDI::USBMIDIpacket_t            receiving;
+    OpenDeckMIDIformat::packetType_t receivedPacketType;
+
+    sending.Event = static_cast<uint8_t>(MIDI::messageType_t::controlChange);
+    sending.Data1 = 0x10;
+    sending.Data2 = 0x20;
+    sending.Data3 = 0x30;
+
+    //some garbage first
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 0x00));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 0x55));
+
+    //burst frame with wrong crc
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, static_cast<uint8_t>(OpenDeckMIDIformat::packetType_t::midiBurst)));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 1));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, sending.Event));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, sending.Data1));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, sending.Data2));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, sending.Data3));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 0x00));
 
-    //next read should return success
+    //burst frame with invalid number of packets
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, static_cast<uint8_t>(OpenDeckMIDIformat::packetType_t::midiBurst)));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, OpenDeckMIDIformat::MAX_BURST_PACKETS + 1));
+
+    //valid frame
+    TEST_ASSERT(OpenDeckMIDIformat::writeMIDI(TEST_MIDI_CHANNEL, sending) == true);
+    TEST_ASSERT(OpenDeckMIDIformat::flush(TEST_MIDI_CHANNEL) == true);
+
+    //corrupted frames should be skipped within single read
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
+    TEST_ASSERT(receivedPacketType == OpenDeckMIDIformat::packetType_t::midi);
+    TEST_ASSERT(receiving.Event == sending.Event);
+    TEST_ASSERT(receiving.Data1 == sending.Data1);
+    TEST_ASSERT(receiving.Data2 == sending.Data2);
+    TEST_ASSERT(receiving.Data3 == sending.Data3);
+
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+}
+
+TEST_CASE(LinkCommands)
+{
+    MIDI::USBMIDIpacket_t            sending;
+    MIDI::USBMIDIpacket_t            receiving;
+    OpenDeckMIDIformat::packetType_t receivedPacketType;
+
+    OpenDeckMIDIformat::buildCommand(sending, OpenDeckMIDIformat::command_t::baudRateChange, 1000000);
+
+    TEST_ASSERT(sending.Event == static_cast<uint8_t>(OpenDeckMIDIformat::command_t::baudRateChange));
+    TEST_ASSERT_EQUAL_UINT32(1000000, OpenDeckMIDIformat::commandValue(sending));
+    TEST_ASSERT(OpenDeckMIDIformat::baudRateSupported(1000000) == true);
+    TEST_ASSERT(OpenDeckMIDIformat::baudRateSupported(UART_BAUDRATE_MIDI_OD) == true);
+    TEST_ASSERT(OpenDeckMIDIformat::baudRateSupported(115200) == false);
+
+    //link commands should be passed to the caller
+    rebootType = Board::rebootType_t::rebootApp;
+
+    TEST_ASSERT(OpenDeckMIDIformat::write(TEST_MIDI_CHANNEL, sending, OpenDeckMIDIformat::packetType_t::internalCommand) == true);
     TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == true);
     TEST_ASSERT(receivedPacketType == OpenDeckMIDIformat::packetType_t::internalCommand);
-    rebootType = Board::rebootType_t::rebootBtldr;
+    TEST_ASSERT(receiving.Event == static_cast<uint8_t>(OpenDeckMIDIformat::command_t::baudRateChange));
+    TEST_ASSERT_EQUAL_UINT32(1000000, OpenDeckMIDIformat::commandValue(receiving));
+    TEST_ASSERT(rebootType == Board::rebootType_t::rebootApp);
+
+    //baud rate change should be tracked
+    TEST_ASSERT(OpenDeckMIDIformat::setBaudRate(TEST_MIDI_CHANNEL, 1000000) == true);
+    TEST_ASSERT_EQUAL_UINT32(1000000, OpenDeckMIDIformat::baudRate());
+    TEST_ASSERT(OpenDeckMIDIformat::setBaudRate(TEST_MIDI_CHANNEL, UART_BAUDRATE_MIDI_OD) == true);
+    TEST_ASSERT_EQUAL_UINT32(UART_BAUDRATE_MIDI_OD, OpenDeckMIDIformat::baudRate());
+
+    //invalid data should be counted as link error
+    uint32_t errorCount = OpenDeckMIDIformat::errorCount();
+
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 0x00));
+    TEST_ASSERT(true == Board::UART::write(TEST_MIDI_CHANNEL, 0x01));
+    TEST_ASSERT(OpenDeckMIDIformat::read(TEST_MIDI_CHANNEL, receiving, receivedPacketType) == false);
+    TEST_ASSERT_EQUAL_UINT32(errorCount + 2, OpenDeckMIDIformat::errorCount());
 }
 
 #endif
@@ -2,12 +2,18 @@
 #include "unity/Helpers.h"
 #include <inttypes.h>
 #include "core/src/general/RingBuffer.h"
+#include "common/SPSCRingBuffer/SPSCRingBuffer.h"
+#include <thread>
 
-#define BUFFER_SIZE 5
+#define BUFFER_SIZE      5
+#define SPSC_BUFFER_SIZE 8
 
 namespace
 {
-    core::RingBuffer<uint8_t, BUFFER_SIZE> buffer;
+    core::RingBuffer<uint8_t, BUFFER_SIZE>      buffer;
+    SPSCRingBuffer<uint8_t, SPSC_BUFFER_SIZE>   spscBuffer;
+    SPSCRingBuffer<uint32_t, SPSC_BUFFER_SIZE>  spscStressBuffer;
+    SPSCRingBuffer<uint16_t, 512>               spscLargeBuffer;
 }
 
 TEST_CASE(Init)
@@ -104,4 +110,162 @@ TEST_CASE(Insertion)
     TEST_ASSERT(1 == buffer.count());
     TEST_ASSERT(buffer.remove(value) == true);
     TEST_ASSERT(12 == value);
-}
\ No newline at end of file
+}
+
+TEST_CASE(SPSCInsertion)
+{
+    spscBuffer.reset();
+
+    TEST_ASSERT(spscBuffer.isEmpty() == true);
+    TEST_ASSERT(spscBuffer.isFull() == false);
+    TEST_ASSERT(0 == spscBuffer.count());
+
+    uint8_t value = 147;
+
+    TEST_ASSERT(spscBuffer.remove(value) == false);
+    TEST_ASSERT(147 == value);
+
+    //go around the buffer several times to verify index wrapping
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < SPSC_BUFFER_SIZE; i++)
+            TEST_ASSERT(spscBuffer.insert(round + i) == true);
+
+        TEST_ASSERT(spscBuffer.insert(0) == false);
+        TEST_ASSERT(spscBuffer.isFull() == true);
+        TEST_ASSERT(SPSC_BUFFER_SIZE == spscBuffer.count());
+        TEST_ASSERT(0 == spscBuffer.freeSpace());
+
+        for (int i = 0; i < SPSC_BUFFER_SIZE; i++)
+        {
+            TEST_ASSERT(spscBuffer.remove(value) == true);
+            TEST_ASSERT(static_cast<uint8_t>(round + i) == value);
+        }
+
+        TEST_ASSERT(spscBuffer.isEmpty() == true);
+
+        //leave the indexes unaligned for the next round
+        TEST_ASSERT(spscBuffer.insert(0) == true);
+        TEST_ASSERT(spscBuffer.remove(value) == true);
+    }
+}
+
+TEST_CASE(SPSCBulk)
+{
+    spscBuffer.reset();
+
+    uint8_t in[SPSC_BUFFER_SIZE + 3];
+    uint8_t out[SPSC_BUFFER_SIZE + 2];
+
+    for (int i = 0; i < SPSC_BUFFER_SIZE + 3; i++)
+        in[i] = i;
+
+    //only as many elements as there is space for should be written
+    TEST_ASSERT(SPSC_BUFFER_SIZE == spscBuffer.write(in, SPSC_BUFFER_SIZE + 2));
+    TEST_ASSERT(spscBuffer.isFull() == true);
+    TEST_ASSERT(0 == spscBuffer.write(in, 1));
+
+    TEST_ASSERT(3 == spscBuffer.read(out, 3));
+    TEST_ASSERT(0 == out[0]);
+    TEST_ASSERT(1 == out[1]);
+    TEST_ASSERT(2 == out[2]);
+    TEST_ASSERT(SPSC_BUFFER_SIZE - 3 == spscBuffer.count());
+
+    //write across the end of the buffer
+    TEST_ASSERT(3 == spscBuffer.write(&in[SPSC_BUFFER_SIZE], 3));
+
+    TEST_ASSERT(SPSC_BUFFER_SIZE == spscBuffer.read(out, SPSC_BUFFER_SIZE + 2));
+
+    for (int i = 0; i < SPSC_BUFFER_SIZE; i++)
+        TEST_ASSERT(i + 3 == out[i]);
+
+    TEST_ASSERT(0 == spscBuffer.read(out, 1));
+    TEST_ASSERT(spscBuffer.isEmpty() == true);
+
+    //large buffers use wider index
+    spscLargeBuffer.reset();
+
+    for (int i = 0; i < 512; i++)
+        TEST_ASSERT(spscLargeBuffer.insert(i) == true);
+
+    TEST_ASSERT(spscLargeBuffer.insert(0) == false);
+    TEST_ASSERT(512 == spscLargeBuffer.count());
+}
+
+TEST_CASE(SPSCStress)
+{
+    spscStressBuffer.reset();
+
+    const uint32_t totalValues = 1000000;
+    bool           orderValid  = true;
+
+    //consumer removes elements both one by one and in bulk, same for producer
+    //yield when there is no progress so that the test runs fine on a single core
+    std::thread consumer([&]() {
+        uint32_t expected = 0;
+        uint32_t values[5];
+
+        while (expected < totalValues)
+        {
+            if (expected % 2)
+            {
+                size_t amount = spscStressBuffer.read(values, 5);
+
+                if (!amount)
+                    std::this_thread::yield();
+
+                for (size_t i = 0; i < amount; i++)
+                {
+                    if (values[i] != expected++)
+                        orderValid = false;
+                }
+            }
+            else
+            {
+                uint32_t value;
+
+                if (spscStressBuffer.remove(value))
+                {
+                    if (value != expected++)
+                        orderValid = false;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    });
+
+    uint32_t next = 0;
+
+    while (next < totalValues)
+    {
+        if (next % 3)
+        {
+            uint32_t values[3];
+            size_t   amount = totalValues - next < 3 ? totalValues - next : 3;
+
+            for (size_t i = 0; i < amount; i++)
+                values[i] = next + i;
+
+            amount = spscStressBuffer.write(values, amount);
+            next += amount;
+
+            if (!amount)
+                std::this_thread::yield();
+        }
+        else
+        {
+            if (spscStressBuffer.insert(next))
+                next++;
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+
+    TEST_ASSERT(orderValid == true);
+    TEST_ASSERT(spscStressBuffer.isEmpty() == true);
+}
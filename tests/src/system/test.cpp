@@ -29,8 +29,9 @@ namespace
 
         void reset()
         {
-            dinMIDIenabled  = false;
-            loopbackEnabled = false;
+            dinMIDIenabled       = false;
+            loopbackEnabled      = false;
+            runningStatusEnabled = false;
         }
 
         bool isDigitalInputAvailable() override
@@ -54,8 +55,24 @@ namespace
             loopbackEnabled = false;
         }
 
-        bool dinMIDIenabled  = false;
-        bool loopbackEnabled = false;
+        void setDINMIDIrunningStatusState(bool state) override
+        {
+            runningStatusEnabled = state;
+        }
+
+        uint32_t dinMIDIbytesPerSecond() override
+        {
+            return 0;
+        }
+
+        bool usbLinkState(uint32_t& baudRate, uint32_t& errorCount) override
+        {
+            return false;
+        }
+
+        bool dinMIDIenabled       = false;
+        bool loopbackEnabled      = false;
+        bool runningStatusEnabled = false;
     } hwaSystem;
 
     class DBhandlers : public Database::Handlers
@@ -153,10 +170,27 @@ namespace
         public:
         HWAAnalog() {}
 
-        bool value(size_t index, uint16_t& value) override
+        void setScanState(size_t index, bool state) override
+        {
+        }
+
+        void setOversamplingState(size_t index, bool state) override
+        {
+        }
+
+        void setPeakDetectionState(size_t index, bool state) override
         {
-            value = adcReturnValue;
-            return true;
+        }
+
+        size_t newValues(uint8_t* indexes, uint16_t* values, size_t maxValues) override
+        {
+            for (size_t i = 0; i < maxValues; i++)
+            {
+                indexes[i] = i;
+                values[i]  = adcReturnValue;
+            }
+
+            return maxValues;
         }
 
         uint32_t adcReturnValue;
@@ -197,6 +231,10 @@ namespace
         void reset(size_t index) override
         {
         }
+
+        void setNoiseThreshold(size_t index, uint16_t threshold) override
+        {
+        }
     } analogFilter;
 
     class HWAButtons : public IO::Buttons::HWA
@@ -208,12 +246,22 @@ namespace
         {
             return false;
         }
+
+        uint32_t stateTime() override
+        {
+            return 0;
+        }
+
+        uint32_t currentTime() override
+        {
+            return 0;
+        }
     } hwaButtons;
 
     class ButtonsFilter : public IO::Buttons::Filter
     {
         public:
-        bool isFiltered(size_t index, bool value, bool& filteredValue) override
+        bool isFiltered(size_t index, bool value, uint32_t time, uint32_t debounceTime, IO::Buttons::debounceMode_t debounceMode, bool& filteredValue) override
         {
             return true;
         }
@@ -229,7 +277,17 @@ namespace
         HWAEncoders()
         {}
 
-        uint8_t state(size_t index) override
+        uint8_t readings() override
+        {
+            return 0;
+        }
+
+        uint8_t state(uint8_t reading, uint8_t group) override
+        {
+            return 0;
+        }
+
+        uint32_t readingTime(uint8_t reading) override
         {
             return 0;
         }
@@ -264,6 +322,16 @@ TEST_CASE(SystemInit)
     //verify that din midi is disabled
     TEST_ASSERT(hwaSystem.dinMIDIenabled == false);
     TEST_ASSERT(hwaSystem.loopbackEnabled == false);
+    TEST_ASSERT(hwaSystem.runningStatusEnabled == false);
+
+    //running status is passed to board on each init
+    TEST_ASSERT(database.update(Database::Section::global_t::midiFeatures, static_cast<size_t>(System::midiFeature_t::runningStatus), 1) == true);
+    TEST_ASSERT(systemStub.init() == true);
+    TEST_ASSERT(hwaSystem.runningStatusEnabled == true);
+
+    TEST_ASSERT(database.update(Database::Section::global_t::midiFeatures, static_cast<size_t>(System::midiFeature_t::runningStatus), 0) == true);
+    TEST_ASSERT(systemStub.init() == true);
+    TEST_ASSERT(hwaSystem.runningStatusEnabled == false);
 
     //now enable din midi via write in database
     TEST_ASSERT(database.update(Database::Section::global_t::midiFeatures, static_cast<size_t>(System::midiFeature_t::dinEnabled), 1) == true);
@@ -465,4 +533,98 @@ TEST_CASE(Requests)
     verifyResponse();
 
     TEST_ASSERT_EQUAL_UINT32(0, hwaMIDI.dinPacketOut.size());
-}
\ No newline at end of file
+}
+#ifdef ANALOG_SUPPORTED
+TEST_CASE(AnalogNoiseThreshold)
+{
+    database.factoryReset();
+
+    std::vector<uint8_t> request;
+    std::vector<uint8_t> response;
+
+    auto sendRequest = [&]() {
+        MIDIHelper::sysExToUSBMIDIPacket(request, hwaMIDI.usbPacketIn);
+
+        size_t sz = hwaMIDI.usbPacketIn.size();
+
+        for (size_t i = 0; i < sz; i++)
+            systemStub.run();
+    };
+
+    auto verifyResponse = [&]() {
+        std::vector<uint8_t> parsed;
+        TEST_ASSERT(MIDIHelper::parseUSBSysEx(hwaMIDI.usbPacketOut, parsed) == true);
+        TEST_ASSERT(parsed == response);
+        hwaMIDI.usbPacketIn.clear();
+        hwaMIDI.usbPacketOut.clear();
+    };
+
+    auto setType = [&](IO::Analog::type_t type) {
+        request = {
+            0xF0,
+            0x00,
+            0x53,
+            0x43,
+            0x00,
+            0x00,
+            0x01,    //set
+            0x00,    //single
+            0x03,    //analog block
+            0x02,    //type
+            0x00,
+            0x00,    //analog component 0
+            0x00,
+            static_cast<uint8_t>(type),
+            0xF7
+        };
+
+        response    = request;
+        response[4] = 0x01;
+
+        sendRequest();
+        verifyResponse();
+    };
+
+    //handshake
+    request = {
+        0xF0,
+        0x00,
+        0x53,
+        0x43,
+        0x00,
+        0x00,
+        0x01,
+        0xF7
+    };
+
+    response = {
+        0xF0,
+        0x00,
+        0x53,
+        0x43,
+        0x01,
+        0x00,
+        0x01,
+        0xF7
+    };
+
+    sendRequest();
+    verifyResponse();
+
+    //calibrated threshold should be kept while the type uses the same readings
+    TEST_ASSERT(database.update(Database::Section::analog_t::noiseThreshold, 0, 5) == true);
+    setType(IO::Analog::type_t::potentiometerNote);
+    TEST_ASSERT_EQUAL_UINT32(5, database.read(Database::Section::analog_t::noiseThreshold, 0));
+
+    //oversampled readings have different range - threshold needs to be measured again
+    setType(IO::Analog::type_t::cc14bit);
+    TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::noiseThreshold, 0));
+
+    TEST_ASSERT(database.update(Database::Section::analog_t::noiseThreshold, 0, 20) == true);
+    setType(IO::Analog::type_t::pitchBend);
+    TEST_ASSERT_EQUAL_UINT32(20, database.read(Database::Section::analog_t::noiseThreshold, 0));
+
+    setType(IO::Analog::type_t::potentiometerControlChange);
+    TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::analog_t::noiseThreshold, 0));
+}
+#endif
@@ -0,0 +1,162 @@
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include <inttypes.h>
+#include <vector>
+#include "common/TimerWheel/TimerWheel.h"
+
+#define NUMBER_OF_TIMERS 10
+#define NUMBER_OF_SLOTS  8
+
+namespace
+{
+    TimerWheel<NUMBER_OF_TIMERS, NUMBER_OF_SLOTS> timerWheel;
+    std::vector<size_t>                           expired;
+
+    void advance(uint16_t tick)
+    {
+        expired.clear();
+
+        timerWheel.advance(tick, [](size_t id) {
+            expired.push_back(id);
+        });
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    timerWheel.reset();
+    advance(0);
+}
+
+TEST_CASE(Expiry)
+{
+    timerWheel.start(0, 3);
+    timerWheel.start(1, 5);
+    TEST_ASSERT(timerWheel.count() == 2);
+    TEST_ASSERT(timerWheel.isActive(0) == true);
+    TEST_ASSERT(timerWheel.isActive(2) == false);
+
+    advance(2);
+    TEST_ASSERT(expired.size() == 0);
+
+    advance(3);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 0);
+    TEST_ASSERT(timerWheel.isActive(0) == false);
+
+    //timer should expire even if the exact tick is skipped
+    advance(7);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 1);
+    TEST_ASSERT(timerWheel.count() == 0);
+}
+
+TEST_CASE(MultipleRounds)
+{
+    //timers further away than the amount of slots share the slot with closer ones
+    timerWheel.start(0, 2);
+    timerWheel.start(1, 2 + NUMBER_OF_SLOTS);
+    timerWheel.start(2, 2 + NUMBER_OF_SLOTS * 3);
+
+    for (uint16_t tick = 1; tick <= NUMBER_OF_SLOTS * 4; tick++)
+    {
+        advance(tick);
+
+        if (tick == 2)
+        {
+            TEST_ASSERT(expired.size() == 1);
+            TEST_ASSERT(expired.at(0) == 0);
+        }
+        else if (tick == 2 + NUMBER_OF_SLOTS)
+        {
+            TEST_ASSERT(expired.size() == 1);
+            TEST_ASSERT(expired.at(0) == 1);
+        }
+        else if (tick == 2 + NUMBER_OF_SLOTS * 3)
+        {
+            TEST_ASSERT(expired.size() == 1);
+            TEST_ASSERT(expired.at(0) == 2);
+        }
+        else
+        {
+            TEST_ASSERT(expired.size() == 0);
+        }
+    }
+
+    //all timers should expire when large amount of ticks elapse at once
+    for (size_t i = 0; i < NUMBER_OF_TIMERS; i++)
+        timerWheel.start(i, 100 + i * 7);
+
+    advance(1000);
+    TEST_ASSERT(expired.size() == NUMBER_OF_TIMERS);
+    TEST_ASSERT(timerWheel.count() == 0);
+}
+
+TEST_CASE(StopAndRestart)
+{
+    timerWheel.start(0, 4);
+    timerWheel.start(1, 4);
+    timerWheel.start(2, 4);
+
+    //stop the timer in the middle of the slot list
+    timerWheel.stop(1);
+    TEST_ASSERT(timerWheel.isActive(1) == false);
+    TEST_ASSERT(timerWheel.count() == 2);
+
+    //stopping inactive timer shouldn't have any effect
+    timerWheel.stop(1);
+    TEST_ASSERT(timerWheel.count() == 2);
+
+    //restarting should replace pending timer
+    timerWheel.start(2, 6);
+    TEST_ASSERT(timerWheel.count() == 2);
+
+    advance(4);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 0);
+
+    advance(6);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 2);
+}
+
+TEST_CASE(Periodic)
+{
+    uint16_t tick  = 0;
+    size_t   calls = 0;
+
+    timerWheel.start(0, 3);
+
+    //restart the timer from handler
+    for (int i = 0; i < 30; i++)
+    {
+        tick++;
+
+        timerWheel.advance(tick, [&](size_t id) {
+            calls++;
+            timerWheel.start(id, tick + 3);
+        });
+    }
+
+    TEST_ASSERT(calls == 10);
+    TEST_ASSERT(timerWheel.isActive(0) == true);
+}
+
+TEST_CASE(Wraparound)
+{
+    advance(65530);
+
+    timerWheel.start(0, 65534);
+    timerWheel.start(1, 4);
+
+    advance(65534);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 0);
+
+    advance(3);
+    TEST_ASSERT(expired.size() == 0);
+
+    advance(4);
+    TEST_ASSERT(expired.size() == 1);
+    TEST_ASSERT(expired.at(0) == 1);
+}
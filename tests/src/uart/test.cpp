@@ -0,0 +1,114 @@
+#if defined(DIN_MIDI_SUPPORTED) && defined(FW_APP)
+
+#include "unity/src/unity.h"
+#include "unity/Helpers.h"
+#include "board/Board.h"
+#include "board/Internal.h"
+#include <vector>
+
+#define TEST_UART_CHANNEL UART_CHANNEL_DIN
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace UART
+        {
+            namespace ll
+            {
+                //data empty interrupt is never fired - outgoing data stays in TX buffer until read in test
+                void enableDataEmptyInt(uint8_t channel)
+                {
+                }
+
+                void disableDataEmptyInt(uint8_t channel)
+                {
+                }
+
+                bool init(uint8_t channel, uint32_t baudRate)
+                {
+                    return true;
+                }
+
+                bool deInit(uint8_t channel)
+                {
+                    return true;
+                }
+            }    // namespace ll
+        }        // namespace UART
+
+#ifdef LED_INDICATORS
+        namespace io
+        {
+            void indicateMIDItraffic(MIDI::interface_t source, midiTrafficDirection_t direction)
+            {
+            }
+        }    // namespace io
+#endif
+    }    // namespace detail
+}    // namespace Board
+
+namespace
+{
+    void receive(std::vector<uint8_t> data)
+    {
+        for (size_t i = 0; i < data.size(); i++)
+            Board::detail::UART::storeIncomingData(TEST_UART_CHANNEL, data[i]);
+    }
+
+    std::vector<uint8_t> transmitted()
+    {
+        std::vector<uint8_t> wire;
+        uint8_t              data;
+        size_t               remainingBytes;
+
+        while (Board::detail::UART::getNextByteToSend(TEST_UART_CHANNEL, data, remainingBytes))
+            wire.push_back(data);
+
+        return wire;
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    TEST_ASSERT(Board::UART::deInit(TEST_UART_CHANNEL) == true);
+    TEST_ASSERT(Board::UART::init(TEST_UART_CHANNEL, 31250) == true);
+
+    Board::UART::setMIDIrunningStatusState(TEST_UART_CHANNEL, true);
+    Board::UART::setLoopbackState(TEST_UART_CHANNEL, true);
+}
+
+TEST_CASE(LoopbackTxFull)
+{
+    //fill the TX buffer with note on messages on the same channel
+    for (int i = 0; i < 128; i++)
+        receive({ 0x90, static_cast<uint8_t>(i), 0x7F });
+
+    auto wire = transmitted();
+
+    //only complete messages should be sent: full first message and running status for the rest
+    TEST_ASSERT(wire.size() >= 3);
+    TEST_ASSERT_EQUAL_UINT32(1, wire.size() % 2);
+    TEST_ASSERT_EQUAL_UINT32(0x90, wire.at(0));
+
+    for (size_t i = 1; i < wire.size(); i += 2)
+    {
+        TEST_ASSERT_EQUAL_UINT32(i / 2, wire.at(i));
+        TEST_ASSERT_EQUAL_UINT32(0x7F, wire.at(i + 1));
+    }
+
+    //messages received once there is space again must be correct on the wire
+    receive({ 0x90, 0x10, 0x7F });
+    receive({ 0x80, 0x10, 0x00 });
+
+    wire = transmitted();
+
+    std::vector<uint8_t> expected = { 0x10, 0x7F, 0x80, 0x10, 0x00 };
+
+    TEST_ASSERT_EQUAL_UINT32(expected.size(), wire.size());
+
+    for (size_t i = 0; i < expected.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(expected.at(i), wire.at(i));
+}
+
+#endif